@@ -9,8 +9,14 @@ extern "C" {
 }
 #include <zlib.h>
 
+#include <algorithm>
 #include <cstring>
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace bgcode {
 
@@ -653,55 +659,81 @@ EResult ThumbnailBlock::read_data(FILE& file, const FileHeader& file_header, con
     return EResult::Success;
 }
 
-EResult GCodeBlock::write(FILE& file, ECompressionType compression_type, EChecksumType checksum_type) const
+// G-code block encoded and compressed in memory, to be written to file by write_gcode_block().
+struct EncodedGCodeBlock
 {
-    if (encoding_type > gcode_encoding_types_count())
-        return EResult::InvalidGCodeEncodingType;
-
-    BlockHeader block_header((uint16_t)EBlockType::GCode, (uint16_t)compression_type, (uint32_t)0);
+    EResult result{ EResult::Success };
+    BlockHeader block_header;
+    uint16_t encoding_type{ 0 };
     std::vector<uint8_t> out_data;
+    Checksum checksum{ EChecksumType::None };
+};
+
+// Encode, compress and calculate the checksum of a G-code block. Does not access any shared data,
+// thus multiple blocks may be encoded concurrently.
+static EncodedGCodeBlock encode_gcode_block(const std::string& raw_data, uint16_t encoding_type,
+    ECompressionType compression_type, EChecksumType checksum_type)
+{
+    EncodedGCodeBlock block;
+    block.block_header = BlockHeader((uint16_t)EBlockType::GCode, (uint16_t)compression_type, (uint32_t)0);
+    block.encoding_type = encoding_type;
     if (!raw_data.empty()) {
         // process payload encoding
         std::vector<uint8_t> uncompressed_data;
-        if (!encode_gcode(raw_data, uncompressed_data, (EGCodeEncodingType)encoding_type))
-            return EResult::GCodeEncodingError;
+        if (!encode_gcode(raw_data, uncompressed_data, (EGCodeEncodingType)encoding_type)) {
+            block.result = EResult::GCodeEncodingError;
+            return block;
+        }
         // process payload compression
-        block_header.uncompressed_size = (uint32_t)uncompressed_data.size();
+        block.block_header.uncompressed_size = (uint32_t)uncompressed_data.size();
         std::vector<uint8_t> compressed_data;
         if (compression_type != ECompressionType::None) {
-            if (!compress(uncompressed_data, compressed_data, compression_type))
-                return EResult::DataCompressionError;
-            block_header.compressed_size = (uint32_t)compressed_data.size();
+            if (!compress(uncompressed_data, compressed_data, compression_type)) {
+                block.result = EResult::DataCompressionError;
+                return block;
+            }
+            block.block_header.compressed_size = (uint32_t)compressed_data.size();
         }
-        out_data.swap((compression_type == ECompressionType::None) ? uncompressed_data : compressed_data);
+        block.out_data.swap((compression_type == ECompressionType::None) ? uncompressed_data : compressed_data);
+    }
+
+    if (checksum_type != EChecksumType::None) {
+        block.checksum = Checksum(checksum_type);
+        // update checksum with block header
+        update_checksum(block.checksum, block.block_header);
+        // update checksum with block payload
+        std::vector<uint8_t> data_to_encode =
+            encode(reinterpret_cast<const std::byte*>(&block.encoding_type), sizeof(block.encoding_type));
+        block.checksum.append(data_to_encode.data(), data_to_encode.size());
+        if (!block.out_data.empty())
+            block.checksum.append(static_cast<unsigned char *>(block.out_data.data()), block.out_data.size());
     }
+    return block;
+}
+
+static EResult write_gcode_block(FILE& file, EncodedGCodeBlock& block)
+{
+    if (block.result != EResult::Success)
+        // propagate error
+        return block.result;
 
     // write block header
-    EResult res = block_header.write(file);
+    EResult res = block.block_header.write(file);
     if (res != EResult::Success)
         // propagate error
         return res;
 
     // write block payload
-    if (!write_to_file(file, &encoding_type, sizeof(encoding_type)))
+    if (!write_to_file(file, &block.encoding_type, sizeof(block.encoding_type)))
         return EResult::WriteError;
-    if (!out_data.empty()) {
-        if (!write_to_file(file, out_data.data(), out_data.size()))
+    if (!block.out_data.empty()) {
+        if (!write_to_file(file, block.out_data.data(), block.out_data.size()))
             return EResult::WriteError;
     }
 
     // write checksum
-    if (checksum_type != EChecksumType::None) {
-        Checksum cs(checksum_type);
-        // update checksum with block header
-        update_checksum(cs, block_header);
-        // update checksum with block payload
-        std::vector<uint8_t> data_to_encode =
-            encode(reinterpret_cast<const std::byte*>(&encoding_type), sizeof(encoding_type));
-        cs.append(data_to_encode.data(), data_to_encode.size());
-        if (!out_data.empty())
-            cs.append(static_cast<unsigned char *>(out_data.data()), out_data.size());
-        res = cs.write(file);
+    if (block.checksum.get_type() != EChecksumType::None) {
+        res = block.checksum.write(file);
         if (res != EResult::Success)
             // propagate error
             return res;
@@ -709,6 +741,15 @@ EResult GCodeBlock::write(FILE& file, ECompressionType compression_type, EChecks
     return EResult::Success;
 }
 
+EResult GCodeBlock::write(FILE& file, ECompressionType compression_type, EChecksumType checksum_type) const
+{
+    if (encoding_type > gcode_encoding_types_count())
+        return EResult::InvalidGCodeEncodingType;
+
+    EncodedGCodeBlock block = encode_gcode_block(raw_data, encoding_type, compression_type, checksum_type);
+    return write_gcode_block(file, block);
+}
+
 EResult GCodeBlock::read_data(FILE& file, const FileHeader& file_header, const BlockHeader& block_header)
 {
     const ECompressionType compression_type = (ECompressionType)block_header.compression;
@@ -798,6 +839,8 @@ EResult Binarizer::initialize(FILE& file, const BinarizerConfig& config)
 
     m_file = &file;
     m_config = config;
+    m_gcode_cache_size = config.gcode_block_size;
+    m_gcode_blocks = std::make_shared<GCodeBlocksQueue>(file, config);
 
     // save header
     FileHeader file_header;
@@ -854,21 +897,135 @@ EResult Binarizer::initialize(FILE& file, const BinarizerConfig& config)
     return EResult::Success;
 }
 
-static EResult write_gcode_block(FILE& file, const std::string& raw_data, const BinarizerConfig& config)
+// Compresses the G-code blocks on a fixed pool of worker threads while the G-code is being generated.
+// The blocks are written to file in the order they were pushed. At most as many blocks as there are threads
+// are compressed at once and at most twice as many blocks are kept in memory, pushing a block waits
+// for the oldest one to be compressed and written.
+class Binarizer::GCodeBlocksQueue
 {
-    GCodeBlock block;
-    block.encoding_type = (uint16_t)config.gcode_encoding;
-    block.raw_data = raw_data;
-    return block.write(file, config.compression.gcode, config.checksum);
-}
+public:
+    GCodeBlocksQueue(FILE& file, const BinarizerConfig& config)
+        : m_file(file), m_config(config)
+    {
+        size_t threads = config.gcode_compression_threads;
+        if (threads == 0)
+            threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        if (threads > 1) {
+            m_max_blocks = 2 * threads;
+            m_workers.reserve(threads);
+            for (size_t i = 0; i < threads; ++i)
+                m_workers.emplace_back([this]() { this->worker(); });
+        }
+    }
+
+    ~GCodeBlocksQueue() {
+        {
+            std::scoped_lock<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cond_pending.notify_all();
+        for (std::thread& worker : m_workers)
+            worker.join();
+    }
+
+    EResult push(std::string&& raw_data) {
+        if (m_workers.empty()) {
+            // Compress on the calling thread.
+            EncodedGCodeBlock block = encode_gcode_block(raw_data, (uint16_t)m_config.gcode_encoding,
+                m_config.compression.gcode, m_config.checksum);
+            return write_gcode_block(m_file, block);
+        }
+
+        {
+            std::scoped_lock<std::mutex> lock(m_mutex);
+            m_blocks.emplace_back(std::make_unique<Block>());
+            m_blocks.back()->raw_data = std::move(raw_data);
+        }
+        m_cond_pending.notify_one();
+        while (m_blocks.size() > m_max_blocks) {
+            const EResult res = pop();
+            if (res != EResult::Success)
+                // propagate error
+                return res;
+        }
+        return EResult::Success;
+    }
+
+    // Write all the blocks pushed so far.
+    EResult flush() {
+        while (!m_blocks.empty()) {
+            const EResult res = pop();
+            if (res != EResult::Success)
+                // propagate error
+                return res;
+        }
+        return EResult::Success;
+    }
+
+private:
+    struct Block
+    {
+        std::string raw_data;
+        EncodedGCodeBlock encoded;
+        bool done{ false };
+    };
+
+    void worker() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_cond_pending.wait(lock, [this]() { return m_stop || m_num_started < m_blocks.size(); });
+            if (m_stop)
+                return;
+            // The blocks stay at their addresses while being compressed, only the blocks already compressed
+            // are removed from the front of the queue.
+            Block& block = *m_blocks[m_num_started++];
+            lock.unlock();
+            try {
+                block.encoded = encode_gcode_block(block.raw_data, (uint16_t)m_config.gcode_encoding,
+                    m_config.compression.gcode, m_config.checksum);
+            }
+            catch (...) {
+                block.encoded.result = EResult::WriteError;
+            }
+            block.raw_data = std::string();
+            lock.lock();
+            block.done = true;
+            m_cond_done.notify_all();
+        }
+    }
+
+    EResult pop() {
+        std::unique_ptr<Block> block;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond_done.wait(lock, [this]() { return m_blocks.front()->done; });
+            block = std::move(m_blocks.front());
+            m_blocks.pop_front();
+            --m_num_started;
+        }
+        return write_gcode_block(m_file, block->encoded);
+    }
+
+    FILE& m_file;
+    BinarizerConfig m_config;
+    size_t m_max_blocks{ 0 };
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_cond_pending;
+    std::condition_variable m_cond_done;
+    bool m_stop{ false };
+    // Blocks in the order of the G-code, the first m_num_started of them are being compressed or compressed.
+    std::deque<std::unique_ptr<Block>> m_blocks;
+    size_t m_num_started{ 0 };
+};
 
 EResult Binarizer::append_gcode(const std::string& gcode)
 {
     if (gcode.empty())
         return EResult::Success;
 
-    assert(m_file != nullptr);
-    if (m_file == nullptr)
+    assert(m_file != nullptr && m_gcode_blocks != nullptr);
+    if (m_file == nullptr || m_gcode_blocks == nullptr)
         return EResult::WriteError;
 
     auto it_begin = gcode.begin();
@@ -881,11 +1038,12 @@ EResult Binarizer::append_gcode(const std::string& gcode)
         const size_t line_size = 1 + end_line_pos - begin_pos;
         if (line_size + m_gcode_cache.length() > m_gcode_cache_size) {
             if (!m_gcode_cache.empty()) {
-                const EResult res = write_gcode_block(*m_file, m_gcode_cache, m_config);
+                const EResult res = m_gcode_blocks->push(std::move(m_gcode_cache));
                 if (res != EResult::Success)
                     // propagate error
                     return res;
                 m_gcode_cache.clear();
+                m_gcode_cache.reserve(m_gcode_cache_size);
             }
         }
 
@@ -904,15 +1062,22 @@ EResult Binarizer::finalize()
     if (!m_enabled)
         return EResult::Success;
 
+    if (m_gcode_blocks == nullptr)
+        return EResult::WriteError;
+
     // save gcode cache, if not empty
     if (!m_gcode_cache.empty()) {
-        const EResult res = write_gcode_block(*m_file, m_gcode_cache, m_config);
+        const EResult res = m_gcode_blocks->push(std::move(m_gcode_cache));
+        m_gcode_cache.clear();
         if (res != EResult::Success)
             // propagate error
             return res;
     }
 
-    return EResult::Success;
+    // wait for the blocks being compressed
+    const EResult res = m_gcode_blocks->flush();
+    m_gcode_blocks.reset();
+    return res;
 }
 
 }} // namespace bgcode
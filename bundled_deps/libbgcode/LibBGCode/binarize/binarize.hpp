@@ -4,6 +4,8 @@
 #include "LibBGCode/binarize/export.h"
 #include "LibBGCode/core/core.hpp"
 
+#include <memory>
+
 namespace bgcode { namespace binarize {
 
 struct BGCODE_BINARIZE_EXPORT BaseMetadataBlock
@@ -85,6 +87,13 @@ struct BinarizerConfig
     core::EGCodeEncodingType gcode_encoding{ core::EGCodeEncodingType::None };
     core::EMetadataEncodingType metadata_encoding{ core::EMetadataEncodingType::INI };
     core::EChecksumType checksum{ core::EChecksumType::CRC32 };
+    // Size limit of the uncompressed G-code blocks, in bytes. Bigger blocks compress better,
+    // more of the smaller blocks are compressed in parallel.
+    size_t gcode_block_size{ 65536 };
+    // Number of threads compressing the G-code blocks, 0 for the number of hardware threads.
+    // The compressed blocks are written in the order of the G-code, at most twice as many blocks as there are
+    // threads are kept in memory.
+    size_t gcode_compression_threads{ 0 };
 };
 
 struct BGCODE_BINARIZE_EXPORT BinaryData
@@ -119,6 +128,9 @@ private:
     BinaryData m_binary_data;
     std::string m_gcode_cache;
     size_t m_gcode_cache_size{ 65536 };
+    // G-code blocks being compressed, created by initialize().
+    class GCodeBlocksQueue;
+    std::shared_ptr<GCodeBlocksQueue> m_gcode_blocks;
 };
 
 } // namespace binarize
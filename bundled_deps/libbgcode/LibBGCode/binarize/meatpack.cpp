@@ -57,8 +57,6 @@ static std::string_view trim(const std::string_view& str)
         return std::string_view(&str[start], end - start + 1);
 }
 
-MPBinarizer::LookupTables MPBinarizer::s_lookup_tables = { { 0 }, { 0 }, false, 0 };
-
 MPBinarizer::MPBinarizer(uint8_t flags) : m_flags(flags) {}
 
 void MPBinarizer::initialize(std::vector<uint8_t>& dst)
@@ -122,12 +120,12 @@ void MPBinarizer::binarize_line(const std::string& line, std::vector<uint8_t>& d
         }
         return line;
     };
-    auto is_packable = [](char c) {
-        return (s_lookup_tables.packable[static_cast<uint8_t>(c)] != 0);
+    auto is_packable = [this](char c) {
+        return (m_lookup_tables.packable[static_cast<uint8_t>(c)] != 0);
     };
-    auto pack_chars = [](char low, char high) {
-        return (((s_lookup_tables.value[static_cast<uint8_t>(high)] & 0xF) << 4) |
-            (s_lookup_tables.value[static_cast<uint8_t>(low)] & 0xF));
+    auto pack_chars = [this](char low, char high) {
+        return (((m_lookup_tables.value[static_cast<uint8_t>(high)] & 0xF) << 4) |
+            (m_lookup_tables.value[static_cast<uint8_t>(low)] & 0xF));
     };
 
     if (!line.empty()) {
@@ -203,27 +201,27 @@ void MPBinarizer::append_command(unsigned char cmd, std::vector<uint8_t>& dst) {
 }
 
 void MPBinarizer::initialize_lookup_tables() {
-    if (s_lookup_tables.initialized && m_flags == s_lookup_tables.flags)
+    if (m_lookup_tables.initialized && m_flags == m_lookup_tables.flags)
         return;
 
     for (const auto& [c, value] : ReverseLookupTbl) {
         const int index = static_cast<int>(c);
-        s_lookup_tables.packable[index] = 1;
-        s_lookup_tables.value[index] = value;
+        m_lookup_tables.packable[index] = 1;
+        m_lookup_tables.value[index] = value;
     }
 
     if ((m_flags & Flag_OmitWhitespaces) != 0) {
-        s_lookup_tables.value[static_cast<uint8_t>(SpaceReplacedCharacter)] = ReverseLookupTbl.at(' ');
-        s_lookup_tables.packable[static_cast<uint8_t>(SpaceReplacedCharacter)] = 1;
-        s_lookup_tables.packable[static_cast<uint8_t>(' ')] = 0;
+        m_lookup_tables.value[static_cast<uint8_t>(SpaceReplacedCharacter)] = ReverseLookupTbl.at(' ');
+        m_lookup_tables.packable[static_cast<uint8_t>(SpaceReplacedCharacter)] = 1;
+        m_lookup_tables.packable[static_cast<uint8_t>(' ')] = 0;
     }
     else {
-        s_lookup_tables.packable[static_cast<uint8_t>(SpaceReplacedCharacter)] = 0;
-        s_lookup_tables.packable[static_cast<uint8_t>(' ')] = 1;
+        m_lookup_tables.packable[static_cast<uint8_t>(SpaceReplacedCharacter)] = 0;
+        m_lookup_tables.packable[static_cast<uint8_t>(' ')] = 1;
     }
 
-    s_lookup_tables.initialized = true;
-    s_lookup_tables.flags = m_flags;
+    m_lookup_tables.initialized = true;
+    m_lookup_tables.flags = m_flags;
 }
 
 // See for reference: https://github.com/scottmudge/Prusa-Firmware-MeatPack/blob/MK3_sm_MeatPack/Firmware/meatpack.cpp
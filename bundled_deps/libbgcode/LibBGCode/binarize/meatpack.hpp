@@ -41,7 +41,8 @@ private:
         unsigned char flags;
     };
 
-    static LookupTables s_lookup_tables;
+    // Per instance, so that multiple G-code blocks may be binarized concurrently.
+    LookupTables m_lookup_tables{ { 0 }, { 0 }, false, 0 };
 
     void append_command(unsigned char cmd, std::vector<uint8_t>& dst);
     void initialize_lookup_tables();
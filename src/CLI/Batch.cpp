@@ -0,0 +1,236 @@
+///|/ Copyright (c) preFlight 2025+ oozeBot, LLC
+///|/
+///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
+///|/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/nowide/iostream.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "libslic3r/Model.hpp"
+#include "libslic3r/Print.hpp"
+
+#include "CLI/CLI.hpp"
+
+namespace Slic3r::CLI
+{
+
+namespace pt = boost::property_tree;
+
+// Split a manifest line into command line arguments. Arguments are separated by white space,
+// single or double quotes group an argument containing white space, backslash escapes the next character.
+static std::vector<std::string> split_manifest_line(const std::string &line)
+{
+    std::vector<std::string> args;
+    std::string arg;
+    bool has_arg = false;
+    char quote = 0;
+    for (size_t i = 0; i < line.size(); ++i)
+    {
+        const char c = line[i];
+        if (c == '\\' && i + 1 < line.size() && quote != '\'')
+        {
+            arg += line[++i];
+            has_arg = true;
+        }
+        else if (quote != 0)
+        {
+            if (c == quote)
+                quote = 0;
+            else
+                arg += c;
+        }
+        else if (c == '"' || c == '\'')
+        {
+            quote = c;
+            has_arg = true;
+        }
+        else if (c == ' ' || c == '\t' || c == '\r')
+        {
+            if (has_arg)
+                args.emplace_back(std::move(arg));
+            arg.clear();
+            has_arg = false;
+        }
+        else
+        {
+            arg += c;
+            has_arg = true;
+        }
+    }
+    if (has_arg)
+        args.emplace_back(std::move(arg));
+    return args;
+}
+
+static void write_report(const SliceReport &report)
+{
+    pt::ptree tree;
+    tree.put("input", report.input_file);
+    tree.put("output", report.output_file);
+    tree.put("error", report.error);
+    tree.put("slicing_time", report.slicing_time);
+    tree.put("export_time", report.export_time);
+    const PrintStatistics &stats = report.statistics;
+    tree.put("estimated_normal_print_time", stats.estimated_normal_print_time);
+    tree.put("estimated_silent_print_time", stats.estimated_silent_print_time);
+    tree.put("normal_print_time_seconds", stats.normal_print_time_seconds);
+    tree.put("silent_print_time_seconds", stats.silent_print_time_seconds);
+    tree.put("total_used_filament", stats.total_used_filament);
+    tree.put("total_extruded_volume", stats.total_extruded_volume);
+    tree.put("total_weight", stats.total_weight);
+    tree.put("total_cost", stats.total_cost);
+    tree.put("total_toolchanges", stats.total_toolchanges);
+
+    const std::string file = boost::filesystem::path(report.output_file).replace_extension("json").string();
+    try
+    {
+        boost::nowide::ofstream c(file, std::ios::out | std::ios::trunc);
+        pt::write_json(c, tree);
+    }
+    catch (const std::exception &ex)
+    {
+        BOOST_LOG_TRIVIAL(error) << "Batch: Failed to write report " << file << ": " << ex.what();
+    }
+}
+
+// Run a single job of the manifest. The job arguments are combined with the arguments of the base command line.
+static bool process_batch_job(const Data &cli, const std::vector<std::string> &args, std::string &status)
+{
+    Data job = cli;
+    job.misc_config.erase("batch");
+    job.misc_config.erase("batch_jobs");
+    if (!read_args(job, args))
+    {
+        status = "invalid arguments";
+        return false;
+    }
+
+    PrinterTechnology printer_technology = get_printer_technology(job.overrides_config);
+    DynamicPrintConfig print_config;
+    std::vector<Model> models;
+    {
+        // Loading of the models (3MF with multiple beds) and the transformations touch the global bed state.
+        std::scoped_lock<std::mutex> lock(model_state_mutex());
+        if (!load_print_data(models, print_config, printer_technology, job))
+        {
+            status = "failed to load";
+            return false;
+        }
+        if (!process_transform(job, print_config, models))
+        {
+            status = "failed to transform";
+            return false;
+        }
+    }
+
+    std::vector<SliceReport> reports;
+    bool ok = process_actions(job, print_config, models, &reports);
+    std::string error;
+    for (const SliceReport &report : reports)
+    {
+        if (!report.output_file.empty())
+            write_report(report);
+        // A model that produced no output (e.g. nothing to print) fails the job, even though the CLI continues.
+        if (!report.error.empty())
+        {
+            ok = false;
+            error = report.error;
+        }
+    }
+    status = ok ? "done" : (error.empty() ? "failed" : error);
+    return ok;
+}
+
+bool process_batch(const Data &cli)
+{
+    const std::string manifest = cli.misc_config.opt_string("batch");
+    boost::nowide::ifstream manifest_file;
+    std::istream *is = &boost::nowide::cin;
+    if (manifest != "-")
+    {
+        manifest_file.open(manifest);
+        if (!manifest_file)
+        {
+            boost::nowide::cerr << "Failed to open batch manifest " << manifest << std::endl;
+            return false;
+        }
+        is = &manifest_file;
+    }
+
+    const int num_workers = std::max(1, cli.misc_config.has("batch_jobs") ? cli.misc_config.opt_int("batch_jobs") : 2);
+
+    // The manifest is read line by line while processing, so that jobs may be streamed through the standard input.
+    std::mutex input_mutex;
+    size_t num_jobs_read = 0;
+    auto next_job = [&](size_t &job_idx, std::vector<std::string> &args) -> bool
+    {
+        std::scoped_lock<std::mutex> lock(input_mutex);
+        for (std::string line; std::getline(*is, line);)
+        {
+            // Comment lines start with '#' as their first non-blank character.
+            const size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#')
+                continue;
+            args = split_manifest_line(line);
+            if (args.empty())
+                continue;
+            job_idx = num_jobs_read++;
+            return true;
+        }
+        return false;
+    };
+
+    std::atomic<size_t> num_failed{0};
+    std::mutex output_mutex;
+    auto worker = [&]()
+    {
+        size_t job_idx;
+        std::vector<std::string> args;
+        while (next_job(job_idx, args))
+        {
+            const auto time_start = std::chrono::steady_clock::now();
+            std::string status;
+            bool ok = false;
+            try
+            {
+                ok = process_batch_job(cli, args, status);
+            }
+            catch (const std::exception &ex)
+            {
+                status = ex.what();
+            }
+            if (!ok)
+                ++num_failed;
+            const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count();
+            std::scoped_lock<std::mutex> lock(output_mutex);
+            boost::nowide::cout << "Batch job " << job_idx + 1 << ": " << status << " (" << time << " s)" << std::endl;
+        }
+    };
+
+    // Jobs run on their own threads rather than as TBB tasks: a job blocked on model_state_mutex() must not
+    // be stolen into by another job holding it from within Print::process().
+    std::vector<std::thread> workers;
+    for (int i = 1; i < num_workers; ++i)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread &thread : workers)
+        thread.join();
+
+    boost::nowide::cout << "Batch finished: " << num_jobs_read - num_failed << " of " << num_jobs_read
+                        << " jobs succeeded." << std::endl;
+    return num_failed == 0;
+}
+
+} // namespace Slic3r::CLI
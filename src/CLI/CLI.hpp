@@ -4,10 +4,12 @@
 ///|/
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "libslic3r/Model.hpp"
+#include "libslic3r/Print.hpp"
 #include "CLI_DynamicPrintConfig.hpp"
 
 #ifdef SLIC3R_GUI
@@ -43,6 +45,8 @@ void print_help(bool include_print_options = false, PrinterTechnology printer_te
 // Implemented in Setup.cpp
 
 bool setup(Data &cli, int argc, char **argv);
+// Parse additional command line arguments (without the executable name) into cli.
+bool read_args(Data &cli, const std::vector<std::string> &args);
 
 // Implemented in LoadPrintData.cpp
 
@@ -59,7 +63,29 @@ bool process_transform(Data &cli, const DynamicPrintConfig &print_config, std::v
 
 bool has_full_config_from_profiles(const Data &cli);
 bool process_profiles_sharing(const Data &cli);
-bool process_actions(Data &cli, const DynamicPrintConfig &print_config, std::vector<Model> &models);
+// Result of slicing a single model, filled in by process_actions() if requested.
+struct SliceReport
+{
+    std::string input_file;
+    std::string output_file;
+    // Empty if the model was sliced and exported successfully.
+    std::string error;
+    PrintStatistics statistics;
+    // Wall clock time of Print::process() and of the G-code export, in seconds.
+    double slicing_time{0.};
+    double export_time{0.};
+};
+
+bool process_actions(Data &cli, const DynamicPrintConfig &print_config, std::vector<Model> &models,
+                     std::vector<SliceReport> *reports = nullptr);
+// Guards the global state touched while loading, arranging and applying models (MultipleBeds),
+// so that batch jobs only slice and export concurrently.
+std::mutex &model_state_mutex();
+
+// Implemented in Batch.cpp
+
+// Process the jobs listed in the "batch" manifest. Returns false if any of the jobs failed.
+bool process_batch(const Data &cli);
 
 // Implemented in GuiParams.cpp
 #ifdef SLIC3R_GUI
@@ -2,7 +2,11 @@
 ///|/
 ///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
 ///|/
+#include <cstdint>
 #include <cstdio>
+#include <filesystem>
+#include <map>
+#include <mutex>
 #include <string>
 #include <cstring>
 #include <iostream>
@@ -58,6 +62,41 @@ static void print_config_substitutions(const ConfigSubstitutions &config_substit
                             << "\tsubstituted = \"" << subst.new_value->serialize() << "\"\n";
 }
 
+// Configuration files supplied via --load are parsed once and kept for the following jobs in batch mode.
+// Substitutions are only returned when the file is parsed, thus they are reported once.
+static ConfigSubstitutions load_config_file_cached(const std::string &file,
+                                                   ForwardCompatibilitySubstitutionRule config_substitution_rule,
+                                                   DynamicPrintConfig &config)
+{
+    struct CachedConfigFile
+    {
+        std::filesystem::file_time_type last_write_time;
+        std::uintmax_t file_size;
+        ForwardCompatibilitySubstitutionRule rule;
+        DynamicPrintConfig config;
+    };
+    static std::mutex mutex;
+    static std::map<std::string, CachedConfigFile> cache;
+
+    // The file time of boost::filesystem has a resolution of seconds, which would not detect a file rewritten
+    // between two jobs started within the same second. The native path keeps the UTF-8 file name on Windows.
+    const std::filesystem::path path(boost::filesystem::path(file).native());
+    std::error_code ec;
+    const std::filesystem::file_time_type last_write_time = std::filesystem::last_write_time(path, ec);
+    const std::uintmax_t file_size = ec ? 0 : std::filesystem::file_size(path, ec);
+    std::scoped_lock<std::mutex> lock(mutex);
+    if (auto it = cache.find(file); !ec && it != cache.end() && it->second.last_write_time == last_write_time &&
+                                    it->second.file_size == file_size && it->second.rule == config_substitution_rule)
+    {
+        config = it->second.config;
+        return {};
+    }
+    ConfigSubstitutions config_substitutions = config.load(file, config_substitution_rule);
+    if (!ec)
+        cache[file] = {last_write_time, file_size, config_substitution_rule, config};
+    return config_substitutions;
+}
+
 static bool load_print_config(DynamicPrintConfig &print_config, PrinterTechnology &printer_technology, const Data &cli)
 {
     // first of all load configuration from "--load" if any
@@ -89,7 +128,7 @@ static bool load_print_config(DynamicPrintConfig &print_config, PrinterTechnolog
             ConfigSubstitutions config_substitutions;
             try
             {
-                config_substitutions = config.load(file, config_substitution_rule);
+                config_substitutions = load_config_file_cached(file, config_substitution_rule, config);
             }
             catch (std::exception &ex)
             {
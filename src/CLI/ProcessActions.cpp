@@ -3,6 +3,8 @@
 ///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
 ///|/
 #include <cstdio>
+#include <chrono>
+#include <mutex>
 #include <string>
 #include <cstring>
 #include <iostream>
@@ -302,7 +304,14 @@ static void update_instances_outside_state(Model &model, const DynamicPrintConfi
     model.update_print_volume_state(build_volume);
 }
 
-bool process_actions(Data &cli, const DynamicPrintConfig &print_config, std::vector<Model> &models)
+std::mutex &model_state_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+bool process_actions(Data &cli, const DynamicPrintConfig &print_config, std::vector<Model> &models,
+                     std::vector<SliceReport> *reports)
 {
     DynamicPrintConfig &actions = cli.actions_config;
     DynamicPrintConfig &transform = cli.transform_config;
@@ -384,6 +393,22 @@ bool process_actions(Data &cli, const DynamicPrintConfig &print_config, std::vec
 
         for (Model &model : models)
         {
+            SliceReport *report = nullptr;
+            if (reports)
+            {
+                report = &reports->emplace_back();
+                report->input_file = model.objects.empty() ? "" : model.objects.front()->input_file;
+            }
+            auto report_error = [report](const std::string &error)
+            {
+                boost::nowide::cerr << error << std::endl;
+                if (report)
+                    report->error = error;
+            };
+
+            // Arrangement and the bed state are global, only the slicing and export run concurrently in batch mode.
+            std::unique_lock<std::mutex> lock_model_state(model_state_mutex());
+
             // If all objects have defined instances, their relative positions will be
             // honored when printing (they will be only centered, unless --dont-arrange
             // is supplied); if any object has no instances, it will get a default one
@@ -401,6 +426,8 @@ bool process_actions(Data &cli, const DynamicPrintConfig &print_config, std::vec
 
             Print fff_print;
             PrintBase *print = static_cast<PrintBase *>(&fff_print);
+            const bool telemetry = cli.misc_config.has("telemetry") && cli.misc_config.opt_bool("telemetry");
+            fff_print.telemetry().set_enabled(telemetry);
             if (printer_technology == ptFFF)
             {
                 for (auto *mo : model.objects)
@@ -414,21 +441,28 @@ bool process_actions(Data &cli, const DynamicPrintConfig &print_config, std::vec
             std::string err = print->validate();
             if (!err.empty())
             {
-                boost::nowide::cerr << err << std::endl;
+                report_error(err);
                 return 1;
             }
+            lock_model_state.unlock();
 
             std::string outfile = output;
 
             if (print->empty())
+            {
                 boost::nowide::cout << "Nothing to print for " << outfile
                                     << " . Either the print is empty or no object is fully inside the print volume."
                                     << std::endl;
+                if (report)
+                    report->error = "Nothing to print";
+            }
             else
                 try
                 {
                     std::string outfile_final;
+                    auto time_start = std::chrono::steady_clock::now();
                     print->process();
+                    auto time_sliced = std::chrono::steady_clock::now();
                     if (printer_technology == ptFFF)
                     {
                         // The outfile is processed by a PlaceholderParser.
@@ -442,8 +476,7 @@ bool process_actions(Data &cli, const DynamicPrintConfig &print_config, std::vec
                     {
                         if (Slic3r::rename_file(outfile, outfile_final))
                         {
-                            boost::nowide::cerr << "Renaming file " << outfile << " to " << outfile_final << " failed"
-                                                << std::endl;
+                            report_error("Renaming file " + outfile + " to " + outfile_final + " failed");
                             return false;
                         }
                         outfile = outfile_final;
@@ -451,10 +484,33 @@ bool process_actions(Data &cli, const DynamicPrintConfig &print_config, std::vec
                     // Run the post-processing scripts if defined.
                     run_post_process_scripts(outfile, fff_print.full_print_config());
                     boost::nowide::cout << "Slicing result exported to " << outfile << std::endl;
+                    if (telemetry)
+                    {
+                        const std::string telemetry_file =
+                            boost::filesystem::path(outfile).replace_extension(".telemetry.json").string();
+                        try
+                        {
+                            fff_print.export_telemetry(telemetry_file);
+                            boost::nowide::cout << "Performance telemetry exported to " << telemetry_file << std::endl;
+                        }
+                        catch (const std::exception &ex)
+                        {
+                            // Failing to write the telemetry does not fail the slicing job.
+                            boost::nowide::cerr << ex.what() << std::endl;
+                        }
+                    }
+                    if (report)
+                    {
+                        report->output_file = outfile;
+                        report->statistics = fff_print.print_statistics();
+                        report->slicing_time = std::chrono::duration<double>(time_sliced - time_start).count();
+                        report->export_time =
+                            std::chrono::duration<double>(std::chrono::steady_clock::now() - time_sliced).count();
+                    }
                 }
                 catch (const std::exception &ex)
                 {
-                    boost::nowide::cerr << ex.what() << std::endl;
+                    report_error(ex.what());
                     return false;
                 }
         }
@@ -14,6 +14,9 @@
 
 #include <boost/log/trivial.hpp>
 
+#include <memory>
+#include <mutex>
+
 namespace Slic3r
 {
 
@@ -505,9 +508,20 @@ std::string load_full_print_config(const std::string &print_preset_name,
 
     // check preset bundle
 
-    PresetBundle preset_bundle;
-    if (!load_preset_bundle_from_datadir(preset_bundle))
-        return Slic3r::format("Failed to load data from the datadir '%1%'.", data_dir());
+    // The preset bundle is loaded from the datadir once and reused by the following calls, which saves
+    // parsing of all the vendor and user profiles for each job in batch mode.
+    // The presets are selected below, thus the calls are serialized.
+    static std::mutex preset_bundle_mutex;
+    static std::unique_ptr<PresetBundle> preset_bundle_cached;
+    std::scoped_lock<std::mutex> lock(preset_bundle_mutex);
+    if (!preset_bundle_cached)
+    {
+        auto preset_bundle_loaded = std::make_unique<PresetBundle>();
+        if (!load_preset_bundle_from_datadir(*preset_bundle_loaded))
+            return Slic3r::format("Failed to load data from the datadir '%1%'.", data_dir());
+        preset_bundle_cached = std::move(preset_bundle_loaded);
+    }
+    PresetBundle &preset_bundle = *preset_bundle_cached;
 
     // check existance of required profiles
 
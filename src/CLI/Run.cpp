@@ -17,6 +17,9 @@ int run(int argc, char **argv)
     if (process_profiles_sharing(cli))
         return 1;
 
+    if (cli.misc_config.has("batch"))
+        return process_batch(cli) ? 0 : 1;
+
     bool start_gui = cli.empty() || (cli.actions_config.empty() && !cli.transform_config.has("cut"));
     PrinterTechnology printer_technology = get_printer_technology(cli.overrides_config);
     DynamicPrintConfig print_config = {};
@@ -14,6 +14,7 @@
 #include "libslic3r/PrintConfig.hpp"
 #include "libslic3r/Platform.hpp"
 #include "libslic3r/Utils.hpp"
+#include "libslic3r/MeshSliceCache.hpp"
 #include "libslic3r/Thread.hpp"
 #include "libslic3r/BlacklistedLibraryCheck.hpp"
 #include "libslic3r/Utils/DirectoriesUtils.hpp"
@@ -226,6 +227,16 @@ static bool read(Data &data, int argc, const char *const argv[])
     return true;
 }
 
+bool read_args(Data &data, const std::vector<std::string> &args)
+{
+    // read() expects the executable name at argv[0].
+    std::vector<const char *> argv{"preFlight"};
+    argv.reserve(args.size() + 1);
+    for (const std::string &arg : args)
+        argv.emplace_back(arg.c_str());
+    return read(data, int(argv.size()), argv.data());
+}
+
 static bool setup_common()
 {
     // Mark the main thread for the debugger and for runtime checks.
@@ -388,6 +399,9 @@ bool setup(Data &cli, int argc, char **argv)
 
     set_data_dir(cli.misc_config.has("datadir") ? cli.misc_config.opt_string("datadir") : get_default_datadir());
 
+    if (cli.misc_config.has("mesh_slice_cache_dir"))
+        MeshSliceCache::set_mesh_slice_cache_dir(cli.misc_config.opt_string("mesh_slice_cache_dir"));
+
     // #ifdef SLIC3R_GUI
     //     if (cli.misc_config.has("webdev")) {
     //         Utils::ServiceConfig::instance().set_webdev_enabled(cli.misc_config.opt_bool("webdev"));
@@ -267,6 +267,15 @@ namespace Clipper2Lib
   using Paths64 = std::vector< Path64>;
   using PathsD = std::vector< PathD>;
 
+  //PathView64: a path stored outside of Clipper as consecutive (x, y) int64_t
+  //coordinate pairs. Added to a Clipper64 without being copied into a Path64.
+  struct PathView64 {
+    const int64_t* xy = nullptr;
+    size_t size = 0;
+    Point64 operator[](size_t i) const { return Point64(xy[2 * i], xy[2 * i + 1]); }
+  };
+  using PathViews64 = std::vector<PathView64>;
+
   static const Point64 InvalidPoint64 = Point64(
     (std::numeric_limits<int64_t>::max)(),
     (std::numeric_limits<int64_t>::max)());
@@ -274,6 +274,7 @@ namespace Clipper2Lib {
 		void CleanUp();  // unlike Clear, CleanUp preserves added paths
 		void AddPath(const Path64& path, PathType polytype, bool is_open);
 		void AddPaths(const Paths64& paths, PathType polytype, bool is_open);
+		void AddPaths(const PathViews64& paths, PathType polytype, bool is_open);
 	public:
 		virtual ~ClipperBase();
 		int ErrorCode() const { return error_code_; };
@@ -478,6 +479,18 @@ namespace Clipper2Lib {
 		{
 			AddPaths(clips, PathType::Clip, false);
 		}
+		void AddSubject(const PathViews64& subjects)
+		{
+			AddPaths(subjects, PathType::Subject, false);
+		}
+		void AddOpenSubject(const PathViews64& open_subjects)
+		{
+			AddPaths(open_subjects, PathType::Subject, true);
+		}
+		void AddClip(const PathViews64& clips)
+		{
+			AddPaths(clips, PathType::Clip, false);
+		}
 
 		bool Execute(ClipType clip_type,
 			FillRule fill_rule, Paths64& closed_paths)
@@ -608,28 +608,35 @@ namespace Clipper2Lib {
     list.emplace_back(std::make_unique <LocalMinima>(&vert, polytype, is_open));
   }
 
-  void AddPaths_(const Paths64& paths, PathType polytype, bool is_open,
+  inline size_t PathSize(const Path64& path) { return path.size(); }
+  inline size_t PathSize(const PathView64& path) { return path.size; }
+
+  //Paths is either Paths64 or PathViews64
+  template <typename Paths>
+  void AddPaths_(const Paths& paths, PathType polytype, bool is_open,
     std::vector<Vertex*>& vertexLists, LocalMinimaList& locMinList)
   {
     const auto total_vertex_count =
       std::accumulate(paths.begin(), paths.end(), size_t(0),
-        [](const auto& a, const Path64& path)
-        {return a + path.size(); });
+        [](const auto& a, const auto& path)
+        {return a + PathSize(path); });
     if (total_vertex_count == 0) return;
 
     Vertex* vertices = new Vertex[total_vertex_count], * v = vertices;
-    for (const Path64& path : paths)
+    for (const auto& path : paths)
     {
       //for each path create a circular double linked list of vertices
       Vertex* v0 = v, * curr_v = v, * prev_v = nullptr;
 
-      if (path.empty())
+      const size_t path_size = PathSize(path);
+      if (path_size == 0)
         continue;
 
       v->prev = nullptr;
       int cnt = 0;
-      for (const Point64& pt : path)
+      for (size_t i = 0; i < path_size; ++i)
       {
+        const Point64 pt = path[i];
         if (prev_v)
         {
           if (prev_v->pt == pt) continue; // ie skips duplicates
@@ -840,6 +847,13 @@ namespace Clipper2Lib {
     AddPaths_(paths, polytype, is_open, vertex_lists_, minima_list_);
   }
 
+  void ClipperBase::AddPaths(const PathViews64& paths, PathType polytype, bool is_open)
+  {
+    if (is_open) has_open_paths_ = true;
+    minima_list_sorted_ = false;
+    AddPaths_(paths, polytype, is_open, vertex_lists_, minima_list_);
+  }
+
   void ClipperBase::AddReuseableData(const ReuseableDataContainer64& reuseable_data)
   {
     // nb: reuseable_data will continue to own the vertices
@@ -434,7 +434,8 @@ BuildVolume::ObjectState BuildVolume::volume_state_bbox(const BoundingBoxf3 volu
 bool BuildVolume::all_paths_inside(const GCodeProcessorResult &paths, const BoundingBoxf3 &paths_bbox,
                                    bool ignore_bottom) const
 {
-    auto move_valid = [](const GCodeProcessorResult::MoveVertex &move)
+    using MoveRef = GCodeProcessorResult::MoveVertices::ConstRef;
+    auto move_valid = [](const MoveRef &move)
     {
         return move.type == EMoveType::Extrude && move.extrusion_role != GCodeExtrusionRole::Custom &&
                move.width != 0.f && move.height != 0.f;
@@ -459,11 +460,10 @@ bool BuildVolume::all_paths_inside(const GCodeProcessorResult &paths, const Boun
         const float r2 = sqr(r);
         return m_max_print_height == 0.0
                    ? std::all_of(paths.moves.begin(), paths.moves.end(),
-                                 [move_valid, c, r2](const GCodeProcessorResult::MoveVertex &move)
+                                 [move_valid, c, r2](const MoveRef &move)
                                  { return !move_valid(move) || (to_2d(move.position) - c).squaredNorm() <= r2; })
                    : std::all_of(paths.moves.begin(), paths.moves.end(),
-                                 [move_valid, c, r2,
-                                  z = m_max_print_height + epsilon](const GCodeProcessorResult::MoveVertex &move)
+                                 [move_valid, c, r2, z = m_max_print_height + epsilon](const MoveRef &move)
                                  {
                                      return !move_valid(move) ||
                                             ((to_2d(move.position) - c).squaredNorm() <= r2 && move.position.z() <= z);
@@ -474,15 +474,14 @@ bool BuildVolume::all_paths_inside(const GCodeProcessorResult &paths, const Boun
     case Type::Custom:
         return m_max_print_height == 0.0
                    ? std::all_of(paths.moves.begin(), paths.moves.end(),
-                                 [move_valid, this](const GCodeProcessorResult::MoveVertex &move)
+                                 [move_valid, this](const MoveRef &move)
                                  {
                                      return !move_valid(move) ||
                                             Geometry::inside_convex_polygon(m_top_bottom_convex_hull_decomposition_bed,
                                                                             to_2d(move.position).cast<double>());
                                  })
                    : std::all_of(paths.moves.begin(), paths.moves.end(),
-                                 [move_valid, this,
-                                  z = m_max_print_height + epsilon](const GCodeProcessorResult::MoveVertex &move)
+                                 [move_valid, this, z = m_max_print_height + epsilon](const MoveRef &move)
                                  {
                                      return !move_valid(move) ||
                                             (Geometry::inside_convex_polygon(m_top_bottom_convex_hull_decomposition_bed,
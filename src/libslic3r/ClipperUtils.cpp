@@ -16,6 +16,7 @@
 #include <cmath>
 #include <type_traits>
 
+#include "ClipperXY.hpp"
 #include "ShortestPath.hpp"
 #include "libslic3r/BoundingBox.hpp"
 #include "libslic3r/ExPolygon.hpp"
@@ -333,26 +334,18 @@ static ExPolygons PolyTreeToExPolygons(PolyTree &&polytree)
 
             // Trust PolyTree hierarchy, don't reverse based on winding.
             // The PolyTree already has IsHole() flags - we should trust that, not area/winding.
-            auto contour_path = polypath.Polygon();
-            double area = Clipper2Lib::Area(contour_path);
-
-            // DON'T reverse - trust the PolyTree structure!
-            (*expolygons)[cnt].contour = ClipperPath_to_Slic3rPolygon(contour_path);
+            // The paths are converted straight from the PolyTree nodes without copying them.
+            (*expolygons)[cnt].contour = ClipperPath_to_Slic3rPolygon(polypath.Polygon());
 
             // Collect holes - iterate using indexed access
-            size_t hole_idx = 0;
+            (*expolygons)[cnt].holes.reserve(polypath.Count());
             for (size_t i = 0; i < polypath.Count(); ++i)
             {
                 const Clipper2Lib::PolyPath64 *child = polypath[i];
                 if (child->IsHole())
                 {
                     // Trust PolyTree IsHole() flag, don't reverse holes.
-                    auto hole_path = child->Polygon();
-
-                    // DON'T reverse - trust PolyTree IsHole() flag!
-                    (*expolygons)[cnt].holes.resize(hole_idx + 1);
-                    (*expolygons)[cnt].holes[hole_idx] = ClipperPath_to_Slic3rPolygon(hole_path);
-                    hole_idx++;
+                    (*expolygons)[cnt].holes.emplace_back(ClipperPath_to_Slic3rPolygon(child->Polygon()));
 
                     // Recurse for nested outer polygons within holes
                     for (size_t j = 0; j < child->Count(); ++j)
@@ -539,36 +532,6 @@ static Paths raw_offset(PathsProvider &&paths, float offset, JoinType joinType,
 
 // For move-only types like PolyTree64, always use std::move
 
-// Offset outside by 10um, one by one.
-template<typename PathsProvider>
-static Paths safety_offset(PathsProvider &&paths)
-{
-    return raw_offset(std::forward<PathsProvider>(paths), ClipperSafetyOffset, DefaultJoinType, DefaultMiterLimit);
-}
-
-// Generic template for copyable return types (Paths, etc.)
-template<class TResult, class TSubj, class TClip>
-typename std::enable_if<!std::is_same<TResult, PolyTree>::value, TResult>::type clipper_do(const ClipType clipType,
-                                                                                           TSubj &&subject,
-                                                                                           TClip &&clip,
-                                                                                           const PolyFillType fillType)
-{
-    CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
-    CLIPPER_METRICS_START();
-
-#ifdef CLIPPER2_VERIFY_USAGE
-    log_clipper_version();
-#endif
-
-    Clipper2Lib::Clipper64 clipper;
-    clipper.AddSubject(PathsProvider_to_Paths64(std::forward<TSubj>(subject)));
-    clipper.AddClip(PathsProvider_to_Paths64(std::forward<TClip>(clip)));
-    TResult retval;
-    clipper.Execute(clipType, fillType, retval);
-    CLIPPER_METRICS_END("clipper_do [Clipper2]");
-    return retval; // Works for copyable types
-}
-
 // Helper for move-only PolyTree type - uses output parameter
 template<class TSubj, class TClip>
 static void clipper_do_polytree_direct(const ClipType clipType, TSubj &&subject, TClip &&clip,
@@ -582,24 +545,12 @@ static void clipper_do_polytree_direct(const ClipType clipType, TSubj &&subject,
 #endif
 
     Clipper2Lib::Clipper64 clipper;
-    clipper.AddSubject(PathsProvider_to_Paths64(std::forward<TSubj>(subject)));
-    clipper.AddClip(PathsProvider_to_Paths64(std::forward<TClip>(clip)));
+    clipper.AddSubject(PathsProvider_to_PathViews64(std::forward<TSubj>(subject)));
+    clipper.AddClip(PathsProvider_to_PathViews64(std::forward<TClip>(clip)));
     clipper.Execute(clipType, fillType, out_result);
     CLIPPER_METRICS_END("clipper_do [Clipper2]");
 }
 
-template<class TResult, class TSubj, class TClip>
-TResult clipper_do(const ClipType clipType, TSubj &&subject, TClip &&clip, const PolyFillType fillType,
-                   const ApplySafetyOffset do_safety_offset)
-{
-    // Safety offset only allowed on intersection and difference.
-    assert(do_safety_offset == ApplySafetyOffset::No || clipType != ctUnion);
-    return do_safety_offset == ApplySafetyOffset::Yes
-               ? clipper_do<TResult>(clipType, std::forward<TSubj>(subject), safety_offset(std::forward<TClip>(clip)),
-                                     fillType)
-               : clipper_do<TResult>(clipType, std::forward<TSubj>(subject), std::forward<TClip>(clip), fillType);
-}
-
 // Generic template for copyable return types (Paths, etc.)
 // NOTE: Do NOT use with TResult=PolyTree - use clipper_union_polytree() instead
 template<class TResult, class TSubj>
@@ -747,16 +698,18 @@ Slic3r::Polygons offset(const Slic3r::Polygon &polygon, const float delta, JoinT
         raw_offset(ClipperUtils::SinglePathProvider(polygon.points), delta, joinType, miterLimit));
 }
 
+// Offsets of Slic3r polygons run on the Clipper2 build without Z, see ClipperXY.hpp.
 Slic3r::Polygons offset(const Slic3r::Polygons &polygons, const float delta, JoinType joinType, double miterLimit)
 {
-    return ClipperPaths_to_Slic3rPolygons(
-        offset_paths<Paths>(ClipperUtils::PolygonsProvider(polygons), delta, joinType, miterLimit));
+    assert(delta != 0);
+    return ClipperXY::offset(ClipperXY::paths_refs(ClipperUtils::PolygonsProvider(polygons)), delta, int(joinType),
+                             miterLimit);
 }
 Slic3r::ExPolygons offset_ex(const Slic3r::Polygons &polygons, const float delta, JoinType joinType, double miterLimit)
 {
-    PolyTree polytree;
-    offset_paths_polytree(ClipperUtils::PolygonsProvider(polygons), delta, joinType, miterLimit, polytree);
-    return PolyTreeToExPolygons(std::move(polytree));
+    assert(delta != 0);
+    return ClipperXY::offset_ex(ClipperXY::paths_refs(ClipperUtils::PolygonsProvider(polygons)), delta, int(joinType),
+                                miterLimit);
 }
 
 Slic3r::Polygons offset(const Slic3r::Polyline &polyline, const float delta, JoinType joinType, double miterLimit,
@@ -878,11 +831,6 @@ static int offset_expolygon_inner(const Slic3r::Surface &surface, const float de
 {
     return offset_expolygon_inner(surface.expolygon, delta, joinType, miterLimit, out);
 }
-static int offset_expolygon_inner(const Slic3r::Surface *surface, const float delta, JoinType joinType,
-                                  double miterLimit, Paths &out)
-{
-    return offset_expolygon_inner(surface->expolygon, delta, joinType, miterLimit, out);
-}
 
 Paths expolygon_offset(const Slic3r::ExPolygon &expolygon, const float delta, JoinType joinType, double miterLimit)
 {
@@ -925,58 +873,45 @@ static Paths expolygons_offset(const ExPolygonVector &expolygons, const float de
                output;
 }
 
-// See comment on expolygons_offset_raw. In addition, the polygons are always united to conver to polytree.
-template<typename ExPolygonVector>
-static void expolygons_offset_pt(const ExPolygonVector &expolygons, const float delta, JoinType joinType,
-                                 double miterLimit, PolyTree &out_result)
-{
-    auto [output, expolygons_collected] = expolygons_offset_raw(expolygons, delta, joinType, miterLimit);
-    // Unite the offsetted expolygons for both the
-    clipper_union_polytree(output, pftNonZero, out_result);
-}
-
 Slic3r::Polygons offset(const Slic3r::ExPolygon &expolygon, const float delta, JoinType joinType, double miterLimit)
 {
-    return ClipperPaths_to_Slic3rPolygons(expolygon_offset(expolygon, delta, joinType, miterLimit));
+    return ClipperXY::offset(ClipperXY::ExPolygonsRefs{&expolygon}, delta, int(joinType), miterLimit);
 }
 Slic3r::Polygons offset(const Slic3r::ExPolygons &expolygons, const float delta, JoinType joinType, double miterLimit)
 {
-    return ClipperPaths_to_Slic3rPolygons(expolygons_offset(expolygons, delta, joinType, miterLimit));
+    return ClipperXY::offset(ClipperXY::expolygons_refs(expolygons), delta, int(joinType), miterLimit);
 }
 Slic3r::Polygons offset(const Slic3r::Surfaces &surfaces, const float delta, JoinType joinType, double miterLimit)
 {
-    return ClipperPaths_to_Slic3rPolygons(expolygons_offset(surfaces, delta, joinType, miterLimit));
+    return ClipperXY::offset(ClipperXY::expolygons_refs(surfaces), delta, int(joinType), miterLimit);
 }
 Slic3r::Polygons offset(const Slic3r::SurfacesPtr &surfaces, const float delta, JoinType joinType, double miterLimit)
 {
-    return ClipperPaths_to_Slic3rPolygons(expolygons_offset(surfaces, delta, joinType, miterLimit));
+    return ClipperXY::offset(ClipperXY::expolygons_refs(surfaces), delta, int(joinType), miterLimit);
 }
 Slic3r::ExPolygons offset_ex(const Slic3r::ExPolygon &expolygon, const float delta, JoinType joinType,
                              double miterLimit)
 //FIXME one may spare one Clipper Union call.
 {
-    return ClipperPaths_to_Slic3rExPolygons(expolygon_offset(expolygon, delta, joinType, miterLimit),
-                                            /* do union */ false);
+    return ClipperXY::offset_ex(ClipperXY::ExPolygonsRefs{&expolygon}, delta, int(joinType), miterLimit,
+                                int(pftEvenOdd));
 }
 Slic3r::ExPolygons offset_ex(const Slic3r::ExPolygons &expolygons, const float delta, JoinType joinType,
                              double miterLimit)
 {
-    PolyTree polytree;
-    expolygons_offset_pt(expolygons, delta, joinType, miterLimit, polytree);
-    return PolyTreeToExPolygons(std::move(polytree));
+    return ClipperXY::offset_ex(ClipperXY::expolygons_refs(expolygons), delta, int(joinType), miterLimit,
+                                int(pftNonZero));
 }
 Slic3r::ExPolygons offset_ex(const Slic3r::Surfaces &surfaces, const float delta, JoinType joinType, double miterLimit)
 {
-    PolyTree polytree;
-    expolygons_offset_pt(surfaces, delta, joinType, miterLimit, polytree);
-    return PolyTreeToExPolygons(std::move(polytree));
+    return ClipperXY::offset_ex(ClipperXY::expolygons_refs(surfaces), delta, int(joinType), miterLimit,
+                                int(pftNonZero));
 }
 Slic3r::ExPolygons offset_ex(const Slic3r::SurfacesPtr &surfaces, const float delta, JoinType joinType,
                              double miterLimit)
 {
-    PolyTree polytree;
-    expolygons_offset_pt(surfaces, delta, joinType, miterLimit, polytree);
-    return PolyTreeToExPolygons(std::move(polytree));
+    return ClipperXY::offset_ex(ClipperXY::expolygons_refs(surfaces), delta, int(joinType), miterLimit,
+                                int(pftNonZero));
 }
 
 // This function offsets ExPolygons such that:
@@ -1139,51 +1074,17 @@ Slic3r::Polygons opening(const Slic3r::Surfaces &surfaces, const float delta1, c
                             delta2, joinType, miterLimit));
 }
 
-// Fix of #117: A large fractal pyramid takes ages to slice
-// The Clipper library has difficulties processing overlapping polygons.
-// Namely, the function ClipperLib::JoinCommonEdges() has potentially a terrible time complexity if the output
-// of the operation is of the PolyTree type.
-// This function implemenets a following workaround:
-// 1) Peform the Clipper operation with the output to Paths. This method handles overlaps in a reasonable time.
-// 2) Run Clipper Union once again to extract the PolyTree from the result of 1).
-// Changed to output parameter to handle move-only PolyTree type
-template<typename PathProvider1, typename PathProvider2>
-inline void clipper_do_polytree(const ClipType clipType, PathProvider1 &&subject, PathProvider2 &&clip,
-                                const PolyFillType fillType, PolyTree &out_result)
-{
-    CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
-
-    // Perform the operation with the output to Paths first.
-    // This pass does not generate a PolyTree, which is a very expensive operation with the current Clipper library
-    // if there are overlapping edges.
-    auto output = clipper_do<Paths>(clipType, subject, clip, fillType);
-    if (!output.empty())
-    {
-        // Perform an additional Union operation to generate the PolyTree ordering.
-        clipper_union_polytree(std::move(output), fillType, out_result);
-    }
-    // else: out_result remains empty (default constructed)
-}
-
-template<typename PathProvider1, typename PathProvider2>
-inline void clipper_do_polytree(const ClipType clipType, PathProvider1 &&subject, PathProvider2 &&clip,
-                                const PolyFillType fillType, const ApplySafetyOffset do_safety_offset,
-                                PolyTree &out_result)
-{
-    assert(do_safety_offset == ApplySafetyOffset::No || clipType != ctUnion);
-    if (do_safety_offset == ApplySafetyOffset::Yes)
-        clipper_do_polytree(clipType, std::forward<PathProvider1>(subject),
-                            safety_offset(std::forward<PathProvider2>(clip)), fillType, out_result);
-    else
-        clipper_do_polytree(clipType, std::forward<PathProvider1>(subject), std::forward<PathProvider2>(clip), fillType,
-                            out_result);
-}
+// Boolean operations of Slic3r polygons carry no Z, they run on the Clipper2 build without Z, see ClipperXY.hpp.
+static_assert(DefaultJoinType == jtSquare, "ClipperXY applies the safety offset with a square join");
 
 template<class TSubj, class TClip>
-static inline Polygons _clipper(ClipType clipType, TSubj &&subject, TClip &&clip, ApplySafetyOffset do_safety_offset)
+static inline Polygons _clipper(ClipType clipType, TSubj &&subject, TClip &&clip, ApplySafetyOffset do_safety_offset,
+                                PolyFillType fill_type = pftNonZero)
 {
-    return ClipperPaths_to_Slic3rPolygons(clipper_do<Paths>(clipType, std::forward<TSubj>(subject),
-                                                            std::forward<TClip>(clip), pftNonZero, do_safety_offset));
+    // Safety offset only allowed on intersection and difference.
+    assert(do_safety_offset == ApplySafetyOffset::No || clipType != ctUnion);
+    return ClipperXY::clip(int(clipType), ClipperXY::paths_refs(subject), ClipperXY::paths_refs(clip), int(fill_type),
+                           do_safety_offset == ApplySafetyOffset::Yes ? ClipperSafetyOffset : 0.f);
 }
 
 Slic3r::Polygons diff(const Slic3r::Polygon &subject, const Slic3r::Polygon &clip, ApplySafetyOffset do_safety_offset)
@@ -1296,9 +1197,8 @@ Slic3r::Polygons union_(const Slic3r::Polygons &subject)
 }
 Slic3r::Polygons union_(const Slic3r::Polygons &subject, const PolyFillType fillType)
 {
-    return ClipperPaths_to_Slic3rPolygons(clipper_do<Paths>(ctUnion, ClipperUtils::PolygonsProvider(subject),
-                                                            ClipperUtils::EmptyPathsProvider(), fillType,
-                                                            ApplySafetyOffset::No));
+    return _clipper(ctUnion, ClipperUtils::PolygonsProvider(subject), ClipperUtils::EmptyPathsProvider(),
+                    ApplySafetyOffset::No, fillType);
 }
 Slic3r::Polygons union_(const Slic3r::ExPolygons &subject)
 {
@@ -1333,10 +1233,9 @@ template<typename TSubject, typename TClip>
 static ExPolygons _clipper_ex(ClipType clipType, TSubject &&subject, TClip &&clip, ApplySafetyOffset do_safety_offset,
                               PolyFillType fill_type = pftNonZero)
 {
-    PolyTree polytree;
-    clipper_do_polytree(clipType, std::forward<TSubject>(subject), std::forward<TClip>(clip), fill_type,
-                        do_safety_offset, polytree);
-    return PolyTreeToExPolygons(std::move(polytree));
+    assert(do_safety_offset == ApplySafetyOffset::No || clipType != ctUnion);
+    return ClipperXY::clip_ex(int(clipType), ClipperXY::paths_refs(subject), ClipperXY::paths_refs(clip),
+                              int(fill_type), do_safety_offset == ApplySafetyOffset::Yes ? ClipperSafetyOffset : 0.f);
 }
 
 Slic3r::ExPolygons diff_ex(const Slic3r::Polygons &subject, const Slic3r::Polygons &clip,
@@ -1497,38 +1396,28 @@ Slic3r::ExPolygons union_ex(const Slic3r::Polygons &subject, const Slic3r::Polyg
 }
 Slic3r::ExPolygons union_ex(const Slic3r::ExPolygons &subject)
 {
-    PolyTree polytree;
-    clipper_do_polytree(ctUnion, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::EmptyPathsProvider(),
-                        pftNonZero, polytree);
-    return PolyTreeToExPolygons(std::move(polytree));
+    return _clipper_ex(ctUnion, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::EmptyPathsProvider(),
+                       ApplySafetyOffset::No);
 }
 Slic3r::ExPolygons union_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPolygons &subject2)
 {
-    PolyTree polytree;
-    clipper_do_polytree(ctUnion, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::ExPolygonsProvider(subject2),
-                        pftNonZero, polytree);
-    return PolyTreeToExPolygons(std::move(polytree));
+    return _clipper_ex(ctUnion, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::ExPolygonsProvider(subject2),
+                       ApplySafetyOffset::No);
 }
 Slic3r::ExPolygons union_ex(const Slic3r::Polygons &subject, const Slic3r::ExPolygons &subject2)
 {
-    PolyTree polytree;
-    clipper_do_polytree(ctUnion, ClipperUtils::PolygonsProvider(subject), ClipperUtils::ExPolygonsProvider(subject2),
-                        pftNonZero, polytree);
-    return PolyTreeToExPolygons(std::move(polytree));
+    return _clipper_ex(ctUnion, ClipperUtils::PolygonsProvider(subject), ClipperUtils::ExPolygonsProvider(subject2),
+                       ApplySafetyOffset::No);
 }
 Slic3r::ExPolygons union_ex(const Slic3r::ExPolygons &subject, const Slic3r::Polygons &subject2)
 {
-    PolyTree polytree;
-    clipper_do_polytree(ctUnion, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::PolygonsProvider(subject2),
-                        pftNonZero, polytree);
-    return PolyTreeToExPolygons(std::move(polytree));
+    return _clipper_ex(ctUnion, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::PolygonsProvider(subject2),
+                       ApplySafetyOffset::No);
 }
 Slic3r::ExPolygons union_ex(const Slic3r::Surfaces &subject)
 {
-    PolyTree polytree;
-    clipper_do_polytree(ctUnion, ClipperUtils::SurfacesProvider(subject), ClipperUtils::EmptyPathsProvider(),
-                        pftNonZero, polytree);
-    return PolyTreeToExPolygons(std::move(polytree));
+    return _clipper_ex(ctUnion, ClipperUtils::SurfacesProvider(subject), ClipperUtils::EmptyPathsProvider(),
+                       ApplySafetyOffset::No);
 }
 
 Slic3r::ExPolygons xor_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPolygon &clip,
@@ -1550,12 +1439,8 @@ Polylines _clipper_pl_open(ClipType clipType, PathsProvider1 &&subject, PathsPro
     CLIPPER_UTILS_TIME_LIMIT_MILLIS(CLIPPER_UTILS_TIME_LIMIT_DEFAULT);
 
     Clipper2Lib::Clipper64 clipper;
-
-    Clipper2Lib::Paths64 subject_paths = PathsProvider_to_Paths64(std::forward<PathsProvider1>(subject));
-    Clipper2Lib::Paths64 clip_paths = PathsProvider_to_Paths64(std::forward<PathsProvider2>(clip));
-
-    clipper.AddOpenSubject(subject_paths);
-    clipper.AddClip(clip_paths);
+    clipper.AddOpenSubject(PathsProvider_to_PathViews64(std::forward<PathsProvider1>(subject)));
+    clipper.AddClip(PathsProvider_to_PathViews64(std::forward<PathsProvider2>(clip)));
 
     // When using AddOpenSubject, Execute needs a second Paths64 parameter for open path results
     PolyTree retval;
@@ -1689,12 +1574,10 @@ Polylines _clipper_pl_closed(ClipType clipType, PathProvider1 &&subject, PathPro
     // For clipping closed polygons (to get polylines), we need to use AddSubject (closed)
     // not AddOpenSubject, and retrieve results from the PolyTree, not open_paths
 
-    Clipper2Lib::Paths64 subject_paths = PathsProvider_to_Paths64(std::forward<PathProvider1>(subject));
-    Clipper2Lib::Paths64 clip_paths = PathsProvider_to_Paths64(std::forward<PathProvider2>(clip));
-
     Clipper2Lib::Clipper64 clipper;
-    clipper.AddSubject(subject_paths); // Use AddSubject for closed polygons
-    clipper.AddClip(clip_paths);
+    // Use AddSubject for closed polygons
+    clipper.AddSubject(PathsProvider_to_PathViews64(std::forward<PathProvider1>(subject)));
+    clipper.AddClip(PathsProvider_to_PathViews64(std::forward<PathProvider2>(clip)));
 
     // Execute and get results as Paths64 (closed polygons)
     Clipper2Lib::Paths64 solution;
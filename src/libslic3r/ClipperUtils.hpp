@@ -11,6 +11,7 @@
 #include <assert.h>
 #include <cstddef>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <cassert>
@@ -256,6 +257,26 @@ inline auto PathsProvider_to_Paths64(PathsProvider &&provider)
     return paths;
 }
 
+// Slic3r::Point is a pair of int64_t coordinates, thus Points may be passed to Clipper64 as PathView64
+// without being copied into a Path64.
+static_assert(sizeof(Point) == 2 * sizeof(int64_t) && std::is_same_v<coord_t, int64_t>);
+
+inline Clipper2Lib::PathView64 Slic3rPoints_to_ClipperPathView(const Points &points)
+{
+    return {points.empty() ? nullptr : points.front().data(), points.size()};
+}
+
+// Views of the paths of a PathsProvider. The provider data must outlive the views.
+template<typename PathsProvider>
+inline Clipper2Lib::PathViews64 PathsProvider_to_PathViews64(PathsProvider &&provider)
+{
+    Clipper2Lib::PathViews64 views;
+    views.reserve(provider.size());
+    for (const Points &points : provider)
+        views.emplace_back(Slic3rPoints_to_ClipperPathView(points));
+    return views;
+}
+
 enum class ApplySafetyOffset
 {
     No,
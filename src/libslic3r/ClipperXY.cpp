@@ -0,0 +1,241 @@
+///|/ Copyright (c) preFlight 2025+ oozeBot, LLC
+///|/
+///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
+///|/
+
+// This file is compiled without the precompiled header, which pulls in the Clipper2 headers configured
+// with USINGZ. Here the Clipper2 headers are configured without Z and with the namespace of the clipper2_xy
+// library, so that both Clipper2 builds link side by side.
+#ifdef CLIPPER_CORE_H
+#error "ClipperXY.cpp must not include the Clipper2 headers configured with USINGZ"
+#endif
+#undef USINGZ
+#define Clipper2Lib Clipper2LibXY
+#include <clipper2/clipper.h>
+
+#include "ClipperXY.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace Slic3r::ClipperXY
+{
+
+namespace C2 = Clipper2LibXY;
+
+static C2::Path64 to_path(const Points &points)
+{
+    C2::Path64 path;
+    path.reserve(points.size());
+    for (const Point &pt : points)
+        path.emplace_back(pt.x(), pt.y());
+    return path;
+}
+
+// Slic3r::Point is a pair of int64_t coordinates, thus Points are passed to Clipper64 as PathView64
+// without being copied into a Path64.
+static C2::PathViews64 to_path_views(const PathsRefs &refs)
+{
+    static_assert(sizeof(Point) == 2 * sizeof(int64_t) && std::is_same_v<coord_t, int64_t>);
+    C2::PathViews64 views;
+    views.reserve(refs.size());
+    for (const Points *points : refs)
+        views.push_back({points->empty() ? nullptr : points->front().data(), points->size()});
+    return views;
+}
+
+static Polygon to_polygon(const C2::Path64 &path)
+{
+    Polygon polygon;
+    polygon.points.reserve(path.size());
+    for (const C2::Point64 &pt : path)
+        polygon.points.emplace_back(pt.x, pt.y);
+    return polygon;
+}
+
+static Polygons to_polygons(const C2::Paths64 &paths)
+{
+    Polygons polygons;
+    polygons.reserve(paths.size());
+    for (const C2::Path64 &path : paths)
+        polygons.emplace_back(to_polygon(path));
+    return polygons;
+}
+
+// Same as PolyTreeToExPolygons() in ClipperUtils.cpp: trust the IsHole() flags of the PolyTree.
+static void polytree_to_expolygons_recursive(const C2::PolyPath64 &polypath, ExPolygons &out)
+{
+    out.emplace_back();
+    const size_t idx = out.size() - 1;
+    out[idx].contour = to_polygon(polypath.Polygon());
+    out[idx].holes.reserve(polypath.Count());
+    for (size_t i = 0; i < polypath.Count(); ++i)
+    {
+        const C2::PolyPath64 &child = *polypath[i];
+        if (child.IsHole())
+        {
+            out[idx].holes.emplace_back(to_polygon(child.Polygon()));
+            // Nested outer polygons within the hole.
+            for (size_t j = 0; j < child.Count(); ++j)
+                if (!child[j]->IsHole())
+                    polytree_to_expolygons_recursive(*child[j], out);
+        }
+    }
+}
+
+static ExPolygons to_expolygons(const C2::PolyTree64 &polytree)
+{
+    ExPolygons out;
+    for (size_t i = 0; i < polytree.Count(); ++i)
+        if (!polytree[i]->IsHole())
+            polytree_to_expolygons_recursive(*polytree[i], out);
+    return out;
+}
+
+static void setup_offset(C2::ClipperOffset &co, C2::JoinType join_type, double miter_limit)
+{
+    if (join_type == C2::JoinType::Round)
+        co.ArcTolerance(miter_limit);
+    else
+        co.MiterLimit(miter_limit);
+}
+
+// Same as raw_offset() in ClipperUtils.cpp: offset CCW contours outside, CW contours (holes) inside,
+// one by one, don't unite the output.
+static C2::Paths64 raw_offset(const PathsRefs &refs, float delta, C2::JoinType join_type, double miter_limit)
+{
+    C2::ClipperOffset co;
+    setup_offset(co, join_type, miter_limit);
+    C2::Paths64 out;
+    out.reserve(refs.size());
+    C2::Paths64 out_this;
+    for (const Points *points : refs)
+    {
+        C2::Path64 path = to_path(*points);
+        const bool ccw = C2::IsPositive(path);
+        co.Clear();
+        co.AddPath(path, join_type, C2::EndType::Polygon);
+        co.Execute(ccw ? delta : -delta, out_this);
+        append(out, std::move(out_this));
+    }
+    return out;
+}
+
+static C2::Paths64 union_paths(const C2::Paths64 &paths, C2::FillRule fill_rule)
+{
+    C2::Paths64 out;
+    if (!paths.empty())
+    {
+        C2::Clipper64 clipper;
+        clipper.AddSubject(paths);
+        clipper.Execute(C2::ClipType::Union, fill_rule, out);
+    }
+    return out;
+}
+
+static ExPolygons union_expolygons(const C2::Paths64 &paths, C2::FillRule fill_rule)
+{
+    C2::PolyTree64 polytree;
+    if (!paths.empty())
+    {
+        C2::Clipper64 clipper;
+        clipper.AddSubject(paths);
+        clipper.Execute(C2::ClipType::Union, fill_rule, polytree);
+    }
+    return to_expolygons(polytree);
+}
+
+static C2::Paths64 clip_paths(int clip_type, const PathsRefs &subject, const PathsRefs &clip, C2::FillRule fill_rule,
+                              float clip_safety_offset)
+{
+    C2::Clipper64 clipper;
+    clipper.AddSubject(to_path_views(subject));
+    if (clip_safety_offset != 0.f)
+        // Miter limit is ignored for the square join.
+        clipper.AddClip(raw_offset(clip, clip_safety_offset, C2::JoinType::Square, 0.));
+    else
+        clipper.AddClip(to_path_views(clip));
+    C2::Paths64 out;
+    clipper.Execute(C2::ClipType(clip_type), fill_rule, out);
+    return out;
+}
+
+Polygons clip(int clip_type, const PathsRefs &subject, const PathsRefs &clip, int fill_rule, float clip_safety_offset)
+{
+    return to_polygons(clip_paths(clip_type, subject, clip, C2::FillRule(fill_rule), clip_safety_offset));
+}
+
+ExPolygons clip_ex(int clip_type, const PathsRefs &subject, const PathsRefs &clip, int fill_rule,
+                   float clip_safety_offset)
+{
+    // Fix of #117: A large fractal pyramid takes ages to slice.
+    // Clipper has difficulties producing a PolyTree from overlapping polygons, thus perform the operation
+    // with the output to Paths first, then run Clipper Union once again to extract the PolyTree.
+    return union_expolygons(clip_paths(clip_type, subject, clip, C2::FillRule(fill_rule), clip_safety_offset),
+                            C2::FillRule(fill_rule));
+}
+
+Polygons offset(const PathsRefs &paths, float delta, int join_type, double miter_limit)
+{
+    return to_polygons(union_paths(raw_offset(paths, delta, C2::JoinType(join_type), miter_limit),
+                                   C2::FillRule::NonZero));
+}
+
+ExPolygons offset_ex(const PathsRefs &paths, float delta, int join_type, double miter_limit)
+{
+    C2::Paths64 out = raw_offset(paths, delta, C2::JoinType(join_type), miter_limit);
+    if (delta > 0)
+        // Unite the overlapping offsetted paths before extracting the PolyTree, see offset_paths_polytree().
+        out = union_paths(out, C2::FillRule::NonZero);
+    return union_expolygons(out, C2::FillRule::NonZero);
+}
+
+// Same as offset_expolygon_inner() in ClipperUtils.cpp. Returns number of expolygons collected (0 or 1).
+static int offset_expolygon(const ExPolygon &expoly, float delta, C2::JoinType join_type, double miter_limit,
+                            C2::Paths64 &out)
+{
+    C2::Paths64 contours;
+    {
+        C2::ClipperOffset co;
+        setup_offset(co, join_type, miter_limit);
+        co.AddPath(to_path(expoly.contour.points), join_type, C2::EndType::Polygon);
+        co.Execute(delta, contours);
+    }
+    if (contours.empty())
+        return 0;
+    append(out, std::move(contours));
+    for (const Polygon &hole : expoly.holes)
+    {
+        C2::ClipperOffset co;
+        setup_offset(co, join_type, miter_limit);
+        co.AddPath(to_path(hole.points), join_type, C2::EndType::Polygon);
+        C2::Paths64 holes;
+        // Execute reorients the hole CCW, thus the signum of the offset value is reversed.
+        co.Execute(-delta, holes);
+        append(out, std::move(holes));
+    }
+    return 1;
+}
+
+Polygons offset(const ExPolygonsRefs &expolygons, float delta, int join_type, double miter_limit)
+{
+    C2::Paths64 out;
+    out.reserve(expolygons.size());
+    size_t expolygons_collected = 0;
+    for (const ExPolygon *expoly : expolygons)
+        expolygons_collected += offset_expolygon(*expoly, delta, C2::JoinType(join_type), miter_limit, out);
+    // The outwards offsetted expolygons may intersect, the shrunk ones shall not.
+    return to_polygons(expolygons_collected > 1 && delta > 0 ? union_paths(out, C2::FillRule::NonZero) : out);
+}
+
+ExPolygons offset_ex(const ExPolygonsRefs &expolygons, float delta, int join_type, double miter_limit,
+                     int fill_rule)
+{
+    C2::Paths64 out;
+    out.reserve(expolygons.size());
+    for (const ExPolygon *expoly : expolygons)
+        offset_expolygon(*expoly, delta, C2::JoinType(join_type), miter_limit, out);
+    return union_expolygons(out, C2::FillRule(fill_rule));
+}
+
+} // namespace Slic3r::ClipperXY
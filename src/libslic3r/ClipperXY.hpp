@@ -0,0 +1,76 @@
+///|/ Copyright (c) preFlight 2025+ oozeBot, LLC
+///|/
+///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
+///|/
+#ifndef slic3r_ClipperXY_hpp_
+#define slic3r_ClipperXY_hpp_
+
+#include <type_traits>
+#include <vector>
+
+#include "ExPolygon.hpp"
+#include "Polygon.hpp"
+
+// Polygon operations running on a second build of Clipper2 without the Z coordinate (target clipper2_xy,
+// namespace Clipper2LibXY). Clipper2 is built with USINGZ for ClipperZUtils and the Z callbacks, which makes
+// every Point64 carry a third coordinate. Slic3r polygons have no Z to carry, thus ClipperUtils routes
+// its boolean operations and offsets of polygons here to not convert and process the unused Z.
+//
+// This header must not include the Clipper2 headers: the Clipper2 enums are passed as their integral values,
+// the input polygons as references to their points.
+namespace Slic3r::ClipperXY
+{
+
+// Points of the input paths. The referenced points must outlive the call.
+using PathsRefs = std::vector<const Points *>;
+using ExPolygonsRefs = std::vector<const ExPolygon *>;
+
+// Collect the paths of a ClipperUtils::PathsProvider.
+template<typename PathsProvider>
+inline PathsRefs paths_refs(PathsProvider &&provider)
+{
+    PathsRefs out;
+    out.reserve(provider.size());
+    for (const Points &points : provider)
+        out.emplace_back(&points);
+    return out;
+}
+
+template<typename ExPolygonVector>
+inline ExPolygonsRefs expolygons_refs(const ExPolygonVector &expolygons)
+{
+    ExPolygonsRefs out;
+    out.reserve(expolygons.size());
+    for (const auto &expolygon : expolygons)
+    {
+        if constexpr (std::is_same_v<std::decay_t<decltype(expolygon)>, ExPolygon>)
+            out.emplace_back(&expolygon);
+        else if constexpr (std::is_pointer_v<std::decay_t<decltype(expolygon)>>)
+            out.emplace_back(&expolygon->expolygon);
+        else
+            out.emplace_back(&expolygon.expolygon);
+    }
+    return out;
+}
+
+// Boolean operation of the subject and clip paths. If clip_safety_offset is non-zero, the clip paths are
+// offsetted one by one with a square join before clipping to close the gaps between touching polygons.
+Polygons clip(int clip_type, const PathsRefs &subject, const PathsRefs &clip, int fill_rule, float clip_safety_offset);
+// As above, the result is extracted from a PolyTree.
+ExPolygons clip_ex(int clip_type, const PathsRefs &subject, const PathsRefs &clip, int fill_rule,
+                   float clip_safety_offset);
+
+// Offset CCW contours outside, CW contours (holes) inside, unite the result.
+Polygons offset(const PathsRefs &paths, float delta, int join_type, double miter_limit);
+ExPolygons offset_ex(const PathsRefs &paths, float delta, int join_type, double miter_limit);
+
+// Offset ExPolygons one by one. The input expolygons shall not overlap.
+// For positive offset, the offsetted expolygons are united.
+Polygons offset(const ExPolygonsRefs &expolygons, float delta, int join_type, double miter_limit);
+// The offsetted expolygons are united with fill_rule to extract the ExPolygons.
+ExPolygons offset_ex(const ExPolygonsRefs &expolygons, float delta, int join_type, double miter_limit,
+                     int fill_rule);
+
+} // namespace Slic3r::ClipperXY
+
+#endif // slic3r_ClipperXY_hpp_
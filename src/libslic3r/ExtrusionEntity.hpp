@@ -11,6 +11,8 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <oneapi/tbb/scalable_allocator.h>
+#include <new>
 #include <optional>
 #include <string_view>
 #include <numeric>
@@ -87,6 +89,17 @@ public:
     }
     virtual double length() const = 0;
     virtual double total_volume() const = 0;
+
+    // Extrusion entities are allocated one by one in huge numbers (millions of gap fill and infill paths)
+    // by the threads generating perimeters and infill, and they are released layer by layer.
+    // Allocate them from the thread local pools of the TBB scalable allocator, the same as the Points.
+    static void *operator new(size_t size)
+    {
+        if (void *ptr = scalable_malloc(size))
+            return ptr;
+        throw std::bad_alloc();
+    }
+    static void operator delete(void *ptr) { scalable_free(ptr); }
 };
 
 using ExtrusionEntitiesPtr = std::vector<ExtrusionEntity *>;
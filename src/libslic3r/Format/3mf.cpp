@@ -53,6 +53,9 @@ namespace pt = boost::property_tree;
 
 #include <fast_float.h>
 
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
 // Slightly faster than sprintf("%.9g"), but there is an issue with the karma floating point formatter,
 // https://github.com/boostorg/spirit/pull/586
 // where the exported string is one digit shorter than it should be to guarantee lossless round trip.
@@ -637,8 +640,13 @@ private:
     bool _handle_start_config_metadata(const char **attributes, unsigned int num_attributes);
     bool _handle_end_config_metadata();
 
+    // Splits the mesh of a volume out of the geometry of its object. Thread safe, the meshes of all the volumes
+    // are built in parallel.
+    bool _generate_volume_mesh(const Geometry &geometry, const ObjectMetadata::VolumeMetadata &volume_data,
+                               TriangleMesh &mesh, std::string &error) const;
+    // Adds the volumes with the meshes generated by _generate_volume_mesh() to the object.
     bool _generate_volumes(ModelObject &object, const Geometry &geometry,
-                           const ObjectMetadata::VolumeMetadataList &volumes,
+                           const ObjectMetadata::VolumeMetadataList &volumes, std::vector<TriangleMesh> &&meshes,
                            ConfigSubstitutionContext &config_substitutions);
 
     // callbacks to parse the .rels file
@@ -951,7 +959,14 @@ bool _3MF_Importer::_load_model_from_file(const std::string &filename, Model &mo
                     new_model_object->clear_instances();
                     new_model_object->add_instance(*model_object->instances.back());
                     model_object->delete_last_instance();
-                    if (!_generate_volumes(*new_model_object, *geometry, volumes, config_substitutions))
+                    std::vector<TriangleMesh> meshes(1);
+                    if (std::string error; !_generate_volume_mesh(*geometry, volumes.front(), meshes.front(), error))
+                    {
+                        add_error(error);
+                        return false;
+                    }
+                    if (!_generate_volumes(*new_model_object, *geometry, volumes, std::move(meshes),
+                                           config_substitutions))
                         return false;
                 }
             }
@@ -959,6 +974,26 @@ bool _3MF_Importer::_load_model_from_file(const std::string &filename, Model &mo
         }
     }
 
+    // Objects to generate the volumes of, their meshes are built in parallel below.
+    struct ObjectVolumes
+    {
+        ModelObject *model_object;
+        int model_object_idx;
+        const Geometry *geometry;
+        // Volumes of the object metadata, if present, otherwise the entire geometry as the single volume.
+        const ObjectMetadata::VolumeMetadataList *metadata_volumes{nullptr};
+        ObjectMetadata::VolumeMetadataList geometry_volume;
+        std::vector<TriangleMesh> meshes;
+        std::vector<std::string> errors;
+
+        const ObjectMetadata::VolumeMetadataList &volumes() const
+        {
+            return metadata_volumes != nullptr ? *metadata_volumes : geometry_volume;
+        }
+    };
+    std::vector<ObjectVolumes> objects_volumes;
+    objects_volumes.reserve(m_objects.size());
+
     for (const IdToModelObjectMap::value_type &object : m_objects)
     {
         if (object.second >= int(m_model->objects.size()))
@@ -999,8 +1034,10 @@ bool _3MF_Importer::_load_model_from_file(const std::string &filename, Model &mo
             model_object->sla_drain_holes = std::move(obj_drain_holes->second);
         }
 
-        ObjectMetadata::VolumeMetadataList volumes;
-        ObjectMetadata::VolumeMetadataList *volumes_ptr = nullptr;
+        ObjectVolumes &object_volumes = objects_volumes.emplace_back();
+        object_volumes.model_object = model_object;
+        object_volumes.model_object_idx = object.second;
+        object_volumes.geometry = &obj_geometry->second;
 
         IdToMetadataMap::iterator obj_metadata = m_objects_metadata.find(object.first.second);
         if (obj_metadata != m_objects_metadata.end())
@@ -1034,25 +1071,60 @@ bool _3MF_Importer::_load_model_from_file(const std::string &filename, Model &mo
             }
 
             // select object's detected volumes
-            volumes_ptr = &obj_metadata->second.volumes;
+            object_volumes.metadata_volumes = &obj_metadata->second.volumes;
         }
         else
         {
             // config data not found, this model was not saved using slic3r pe
 
             // add the entire geometry as the single volume to generate
-            volumes.emplace_back(0, (int) obj_geometry->second.triangles.size() - 1);
-
-            // select as volumes
-            volumes_ptr = &volumes;
+            object_volumes.geometry_volume.emplace_back(0, (int) obj_geometry->second.triangles.size() - 1);
         }
+    }
 
-        if (!_generate_volumes(*model_object, obj_geometry->second, *volumes_ptr, config_substitutions))
+    // Building the meshes (splitting the geometry, calculating the mesh statistics) is the bulk of the work
+    // of generating the volumes, build the meshes of all the volumes of all the objects in parallel.
+    std::vector<std::pair<size_t, size_t>> volumes_to_mesh;
+    for (size_t object_idx = 0; object_idx < objects_volumes.size(); ++object_idx)
+    {
+        ObjectVolumes &object_volumes = objects_volumes[object_idx];
+        const size_t volumes_count = object_volumes.volumes().size();
+        object_volumes.meshes.resize(volumes_count);
+        object_volumes.errors.resize(volumes_count);
+        for (size_t volume_idx = 0; volume_idx < volumes_count; ++volume_idx)
+            volumes_to_mesh.emplace_back(object_idx, volume_idx);
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, volumes_to_mesh.size(), 1),
+                      [this, &objects_volumes, &volumes_to_mesh](const tbb::blocked_range<size_t> &range)
+                      {
+                          for (size_t i = range.begin(); i < range.end(); ++i)
+                          {
+                              const auto [object_idx, volume_idx] = volumes_to_mesh[i];
+                              ObjectVolumes &object_volumes = objects_volumes[object_idx];
+                              _generate_volume_mesh(*object_volumes.geometry, object_volumes.volumes()[volume_idx],
+                                                    object_volumes.meshes[volume_idx],
+                                                    object_volumes.errors[volume_idx]);
+                          }
+                      });
+
+    for (ObjectVolumes &object_volumes : objects_volumes)
+    {
+        ModelObject *model_object = object_volumes.model_object;
+        if (auto it = std::find_if(object_volumes.errors.begin(), object_volumes.errors.end(),
+                                   [](const std::string &error) { return !error.empty(); });
+            it != object_volumes.errors.end())
+        {
+            add_error(*it);
+            return false;
+        }
+        if (!_generate_volumes(*model_object, *object_volumes.geometry, object_volumes.volumes(),
+                               std::move(object_volumes.meshes), config_substitutions))
             return false;
 
         // Apply cut information for object if any was loaded
         // m_cut_object_ids are indexed by a 1 based model object index.
-        IdToCutObjectInfoMap::iterator cut_object_info = m_cut_object_infos.find(object.second + 1);
+        IdToCutObjectInfoMap::iterator cut_object_info =
+            m_cut_object_infos.find(object_volumes.model_object_idx + 1);
         if (cut_object_info != m_cut_object_infos.end())
         {
             model_object->cut_id = cut_object_info->second.id;
@@ -2826,8 +2898,64 @@ bool _3MF_Importer::_handle_end_config_metadata()
     return true;
 }
 
+bool _3MF_Importer::_generate_volume_mesh(const Geometry &geometry, const ObjectMetadata::VolumeMetadata &volume_data,
+                                          TriangleMesh &mesh, std::string &error) const
+{
+    unsigned int geo_tri_count = (unsigned int) geometry.triangles.size();
+    if (geo_tri_count <= volume_data.first_triangle_id || geo_tri_count <= volume_data.last_triangle_id ||
+        volume_data.last_triangle_id < volume_data.first_triangle_id)
+    {
+        error = "Found invalid triangle id";
+        return false;
+    }
+
+    // splits volume out of imported geometry
+    indexed_triangle_set its;
+    its.indices.assign(geometry.triangles.begin() + volume_data.first_triangle_id,
+                       geometry.triangles.begin() + volume_data.last_triangle_id + 1);
+    if (its.indices.empty())
+    {
+        error = "An empty triangle mesh found";
+        return false;
+    }
+
+    {
+        int min_id = its.indices.front()[0];
+        int max_id = min_id;
+        for (const Vec3i &face : its.indices)
+        {
+            for (const int tri_id : face)
+            {
+                if (tri_id < 0 || tri_id >= int(geometry.vertices.size()))
+                {
+                    error = "Found invalid vertex id";
+                    return false;
+                }
+                min_id = std::min(min_id, tri_id);
+                max_id = std::max(max_id, tri_id);
+            }
+        }
+        its.vertices.assign(geometry.vertices.begin() + min_id, geometry.vertices.begin() + max_id + 1);
+
+        // rebase indices to the current vertices list
+        for (Vec3i &face : its.indices)
+            for (coord_t &tri_id : face)
+                tri_id -= min_id;
+    }
+
+    if (m_generator_version && *m_generator_version >= *Semver::parse("2.4.0-alpha1") &&
+        *m_generator_version < *Semver::parse("2.4.0-alpha3"))
+        // Handle older 3MF files where all vertices were saved for each volume.
+        // Remove the vertices, that are not referenced by any face.
+        its_compactify_vertices(its, true);
+
+    mesh = TriangleMesh(std::move(its), volume_data.mesh_stats);
+    return true;
+}
+
 bool _3MF_Importer::_generate_volumes(ModelObject &object, const Geometry &geometry,
                                       const ObjectMetadata::VolumeMetadataList &volumes,
+                                      std::vector<TriangleMesh> &&meshes,
                                       ConfigSubstitutionContext &config_substitutions)
 {
     if (!object.volumes.empty())
@@ -2836,17 +2964,14 @@ bool _3MF_Importer::_generate_volumes(ModelObject &object, const Geometry &geome
         return false;
     }
 
-    unsigned int geo_tri_count = (unsigned int) geometry.triangles.size();
+    assert(meshes.size() == volumes.size());
     unsigned int renamed_volumes_count = 0;
 
-    for (const ObjectMetadata::VolumeMetadata &volume_data : volumes)
+    for (size_t volume_idx = 0; volume_idx < volumes.size(); ++volume_idx)
     {
-        if (geo_tri_count <= volume_data.first_triangle_id || geo_tri_count <= volume_data.last_triangle_id ||
-            volume_data.last_triangle_id < volume_data.first_triangle_id)
-        {
-            add_error("Found invalid triangle id");
-            return false;
-        }
+        const ObjectMetadata::VolumeMetadata &volume_data = volumes[volume_idx];
+        TriangleMesh &triangle_mesh = meshes[volume_idx];
+        const size_t triangles_count = triangle_mesh.its.indices.size();
 
         Transform3d volume_matrix_to_object = Transform3d::Identity();
         bool has_transform = false;
@@ -2861,49 +2986,6 @@ bool _3MF_Importer::_generate_volumes(ModelObject &object, const Geometry &geome
             }
         }
 
-        // splits volume out of imported geometry
-        indexed_triangle_set its;
-        its.indices.assign(geometry.triangles.begin() + volume_data.first_triangle_id,
-                           geometry.triangles.begin() + volume_data.last_triangle_id + 1);
-        const size_t triangles_count = its.indices.size();
-        if (triangles_count == 0)
-        {
-            add_error("An empty triangle mesh found");
-            return false;
-        }
-
-        {
-            int min_id = its.indices.front()[0];
-            int max_id = min_id;
-            for (const Vec3i &face : its.indices)
-            {
-                for (const int tri_id : face)
-                {
-                    if (tri_id < 0 || tri_id >= int(geometry.vertices.size()))
-                    {
-                        add_error("Found invalid vertex id");
-                        return false;
-                    }
-                    min_id = std::min(min_id, tri_id);
-                    max_id = std::max(max_id, tri_id);
-                }
-            }
-            its.vertices.assign(geometry.vertices.begin() + min_id, geometry.vertices.begin() + max_id + 1);
-
-            // rebase indices to the current vertices list
-            for (Vec3i &face : its.indices)
-                for (coord_t &tri_id : face)
-                    tri_id -= min_id;
-        }
-
-        if (m_generator_version && *m_generator_version >= *Semver::parse("2.4.0-alpha1") &&
-            *m_generator_version < *Semver::parse("2.4.0-alpha3"))
-            // Handle older 3MF files where all vertices were saved for each volume.
-            // Remove the vertices, that are not referenced by any face.
-            its_compactify_vertices(its, true);
-
-        TriangleMesh triangle_mesh(std::move(its), volume_data.mesh_stats);
-
         if (m_version == 0)
         {
             // if the 3mf was not produced by preFlight and there is only one instance,
@@ -3,11 +3,18 @@
 ///|/
 ///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
 ///|/
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/nowide/cstdio.hpp>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
 #include <LocalesUtils.hpp>
 #include <fast_float.h>
+#include <algorithm>
+#include <iterator>
 #include <new>
+#include <string>
 #include <system_error>
 #include <utility>
 #include <cassert>
@@ -34,7 +41,18 @@ static double strtod_clocale(const char *str, char const **str_end)
     return val;
 }
 
-static bool obj_parseline(const char *line, ObjData &data)
+// Face vertex references relative to the end of the vertex lists ("f -3 -2 -1") of a file parsed in chunks
+// are resolved against the lists of the chunk, they are shifted by the number of items parsed by the preceding
+// chunks when the chunks are merged.
+struct ObjRelativeRef
+{
+    size_t vertexIdx;
+    bool coord;
+    bool textureCoord;
+    bool normal;
+};
+
+static bool obj_parseline(const char *line, ObjData &data, std::vector<ObjRelativeRef> *relative_refs = nullptr)
 {
 #define EATWS()                           \
     while (*line == ' ' || *line == '\t') \
@@ -253,6 +271,10 @@ static bool obj_parseline(const char *line, ObjData &data)
                     line = endptr;
                 }
             }
+            if (relative_refs != nullptr &&
+                (vertex.coordIdx < 0 || vertex.textureCoordIdx < 0 || vertex.normalIdx < 0))
+                relative_refs->push_back({data.vertices.size(), vertex.coordIdx < 0, vertex.textureCoordIdx < 0,
+                                          vertex.normalIdx < 0});
             if (vertex.coordIdx < 0)
                 vertex.coordIdx += (int) data.coordinates.size() / 4;
             else
@@ -352,10 +374,8 @@ static bool obj_parseline(const char *line, ObjData &data)
     return true;
 }
 
-bool objparse(const char *path, ObjData &data)
+static bool objparse_sequential(const char *path, ObjData &data)
 {
-    Slic3r::CNumericLocalesSetter locales_setter;
-
     FILE *pFile = boost::nowide::fopen(path, "rt");
     if (pFile == 0)
         return false;
@@ -412,6 +432,136 @@ bool objparse(const char *path, ObjData &data)
     return true;
 }
 
+// Append the data parsed from a chunk of a file to the data parsed from the preceding chunks.
+static void obj_append(ObjData &data, ObjData &&chunk, const std::vector<ObjRelativeRef> &relative_refs)
+{
+    const int num_coordinates = (int) data.coordinates.size() / 4;
+    const int num_texture_coordinates = (int) data.textureCoordinates.size() / 3;
+    const int num_normals = (int) data.normals.size() / 3;
+    const int num_vertices = (int) data.vertices.size();
+    for (const ObjRelativeRef &ref : relative_refs)
+    {
+        ObjVertex &vertex = chunk.vertices[ref.vertexIdx];
+        if (ref.coord)
+            vertex.coordIdx += num_coordinates;
+        if (ref.textureCoord)
+            vertex.textureCoordIdx += num_texture_coordinates;
+        if (ref.normal)
+            vertex.normalIdx += num_normals;
+    }
+    for (ObjUseMtl &usemtl : chunk.usemtls)
+        usemtl.vertexIdxFirst += num_vertices;
+    for (ObjObject &object : chunk.objects)
+        object.vertexIdxFirst += num_vertices;
+    for (ObjGroup &group : chunk.groups)
+        group.vertexIdxFirst += num_vertices;
+    for (ObjSmoothingGroup &group : chunk.smoothingGroups)
+        group.vertexIdxFirst += num_vertices;
+
+    auto append = [](auto &dst, auto &src) {
+        if (dst.empty())
+            dst = std::move(src);
+        else
+            dst.insert(dst.end(), std::make_move_iterator(src.begin()), std::make_move_iterator(src.end()));
+    };
+    append(data.coordinates, chunk.coordinates);
+    append(data.textureCoordinates, chunk.textureCoordinates);
+    append(data.normals, chunk.normals);
+    append(data.parameters, chunk.parameters);
+    append(data.mtllibs, chunk.mtllibs);
+    append(data.usemtls, chunk.usemtls);
+    append(data.objects, chunk.objects);
+    append(data.groups, chunk.groups);
+    append(data.smoothingGroups, chunk.smoothingGroups);
+    append(data.vertices, chunk.vertices);
+}
+
+bool objparse(const char *path, ObjData &data)
+{
+    Slic3r::CNumericLocalesSetter locales_setter;
+
+    // Memory map the file and parse it in chunks of whole lines in parallel. Fall back to reading the file
+    // through a buffer if it could not be mapped.
+    boost::system::error_code ec;
+    const boost::uintmax_t file_size = boost::filesystem::file_size(path, ec);
+    if (ec || file_size == 0)
+        return objparse_sequential(path, data);
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+        file.open(boost::filesystem::path(path));
+    }
+    catch (const std::exception &ex)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "ObjParser: Failed to memory map " << path << ": " << ex.what()
+                                   << ", falling back to sequential reading.";
+    }
+    if (!file.is_open())
+        return objparse_sequential(path, data);
+
+    const char *const data_begin = file.data();
+    const char *const data_end = data_begin + file.size();
+    // A position following '\n' always starts a new line.
+    static constexpr size_t chunk_size = 4 * 1024 * 1024;
+    std::vector<const char *> chunk_begins{data_begin};
+    for (const char *p = data_begin + chunk_size; p < data_end; p += chunk_size)
+    {
+        p = std::max(p, chunk_begins.back());
+        const char *line_end = static_cast<const char *>(memchr(p, '\n', data_end - p));
+        if (line_end == nullptr)
+            break;
+        chunk_begins.emplace_back(line_end + 1);
+        p = line_end + 1;
+    }
+    chunk_begins.emplace_back(data_end);
+
+    struct Chunk
+    {
+        ObjData data;
+        std::vector<ObjRelativeRef> relative_refs;
+    };
+    std::vector<Chunk> chunks(chunk_begins.size() - 1);
+    try
+    {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, chunks.size(), 1),
+                          [&](const tbb::blocked_range<size_t> &range)
+                          {
+                              // The numeric locale is set per thread.
+                              Slic3r::CNumericLocalesSetter locales_setter;
+                              // obj_parseline() expects a zero terminated line.
+                              std::string line;
+                              for (size_t chunk_idx = range.begin(); chunk_idx < range.end(); ++chunk_idx)
+                              {
+                                  Chunk &chunk = chunks[chunk_idx];
+                                  const char *const chunk_end = chunk_begins[chunk_idx + 1];
+                                  for (const char *p = chunk_begins[chunk_idx]; p != chunk_end;)
+                                  {
+                                      const char *line_end = p;
+                                      while (line_end != chunk_end && *line_end != '\r' && *line_end != '\n')
+                                          ++line_end;
+                                      while (p != line_end && (*p == ' ' || *p == '\t'))
+                                          ++p;
+                                      line.assign(p, line_end);
+                                      //FIXME check the return value and exit on error?
+                                      // Will it break parsing of some obj files?
+                                      obj_parseline(line.c_str(), chunk.data, &chunk.relative_refs);
+                                      p = line_end == chunk_end ? chunk_end : line_end + 1;
+                                  }
+                              }
+                          });
+        for (Chunk &chunk : chunks)
+        {
+            obj_append(data, std::move(chunk.data), chunk.relative_refs);
+            chunk = Chunk();
+        }
+    }
+    catch (std::bad_alloc &)
+    {
+        BOOST_LOG_TRIVIAL(error) << "ObjParser: Out of memory";
+    }
+    return true;
+}
+
 bool objparse(std::istream &stream, ObjData &data)
 {
     Slic3r::CNumericLocalesSetter locales_setter;
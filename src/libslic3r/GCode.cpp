@@ -795,7 +795,11 @@ void GCodeGenerator::do_export(Print *print, const char *path, GCodeProcessorRes
     }
 
     // Post-process the G-code to update time stamps.
-    m_processor.finalize(true);
+    {
+        PrintTelemetry::Scope telemetry(print->telemetry(), "gcode.processor_finalize", 0,
+                                        PrintTelemetry::CpuTime::Process);
+        m_processor.finalize(true);
+    }
     //    DoExport::update_print_estimated_times_stats(m_processor, print->m_print_statistics);
     DoExport::update_print_estimated_stats(m_processor, m_writer.extruders(), print->m_print_statistics);
     if (result != nullptr)
@@ -834,11 +838,14 @@ void GCodeGenerator::do_export(Print *print, const char *path, GCodeProcessorRes
 
         if (vf_to_export)
         {
-            // Write each line efficiently
-            for (size_t i = 0; i < vf_to_export->line_count(); ++i)
+            // The buffer holds the final G-code, write it at once.
+            const std::string &buffer = vf_to_export->get_buffer();
+            fwrite(buffer.data(), 1, buffer.size(), output_file);
+            if (ferror(output_file))
             {
-                std::string line = vf_to_export->get_line(i);
-                fwrite(line.c_str(), 1, line.length(), output_file);
+                fclose(output_file);
+                throw Slic3r::RuntimeError(std::string("Failed to write the output G-code file ") + path +
+                                           "\nIs the disk full?");
             }
         }
 
@@ -1456,6 +1463,10 @@ void GCodeGenerator::_do_export(Print &print, GCodeOutputStream &file, Thumbnail
 
     m_cooling_buffer = make_unique<CoolingBuffer>(*this);
     m_cooling_buffer->set_current_extruder(initial_extruder_id);
+    // The cooling buffer looks the moves formatted by the writer up instead of parsing them again,
+    // unless the vase mode or the pressure equalizer rewrite them on the way.
+    m_layer_moves.clear();
+    m_writer.set_moves(m_spiral_vase || m_pressure_equalizer ? nullptr : &m_layer_moves);
 
     // Emit machine envelope limits for the Marlin firmware.
     this->print_machine_envelope(file, print);
@@ -1870,10 +1881,10 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
     size_t layer_to_print_idx = 0;
     const GCode::SmoothPathCache::InterpolationParameters interpolation_params = interpolation_parameters(
         print.config());
-    const auto smooth_path_interpolator = tbb::make_filter<void, std::pair<size_t, GCode::SmoothPathCache>>(
+    const auto layer_input = tbb::make_filter<void, std::pair<size_t, GCode::SmoothPathCache>>(
         slic3r_tbb_filtermode::serial_in_order,
-        [this, &print, &layers_to_print, &layer_to_print_idx,
-         &interpolation_params](tbb::flow_control &fc) -> std::pair<size_t, GCode::SmoothPathCache>
+        [this, &print, &layers_to_print,
+         &layer_to_print_idx](tbb::flow_control &fc) -> std::pair<size_t, GCode::SmoothPathCache>
         {
             if (layer_to_print_idx >= layers_to_print.size())
             {
@@ -1900,12 +1911,25 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
                     int progress = 33 + static_cast<int>(((idx + 1) * 17.0) / layers_to_print.size());
                     const_cast<Print &>(print).set_status(progress, _u8L("Generating G-code layers"));
                 }
-                GCode::SmoothPathCache smooth_path_cache;
-                for (const ObjectLayerToPrint &l : layers_to_print[idx].second)
-                    GCodeGenerator::smooth_path_interpolate(l, interpolation_params, smooth_path_cache);
-                return {idx, std::move(smooth_path_cache)};
+                return {idx, {}};
             }
         });
+    // Arc fitting of a layer does not depend on the other layers, thus the layers are interpolated in parallel.
+    const auto smooth_path_interpolator =
+        tbb::make_filter<std::pair<size_t, GCode::SmoothPathCache>, std::pair<size_t, GCode::SmoothPathCache>>(
+            slic3r_tbb_filtermode::parallel,
+            [&print, &layers_to_print, &interpolation_params](
+                std::pair<size_t, GCode::SmoothPathCache> in) -> std::pair<size_t, GCode::SmoothPathCache>
+            {
+                if (in.first < layers_to_print.size())
+                {
+                    PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.smooth_path_interpolate", 1);
+                    print.throw_if_canceled();
+                    for (const ObjectLayerToPrint &l : layers_to_print[in.first].second)
+                        GCodeGenerator::smooth_path_interpolate(l, interpolation_params, in.second);
+                }
+                return in;
+            });
     const auto generator = tbb::make_filter<std::pair<size_t, GCode::SmoothPathCache>, LayerResult>(
         slic3r_tbb_filtermode::serial_in_order,
         [this, &print, &tool_ordering, &print_object_instances_ordering, &layers_to_print,
@@ -1920,6 +1944,7 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
             }
             else
             {
+                PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.generate", 1);
                 const std::pair<coordf_t, ObjectsLayerToPrint> &layer = layers_to_print[layer_to_print_idx];
                 const LayerTools &layer_tools = tool_ordering.tools_for_layer(layer.first);
                 if (m_wipe_tower && layer_tools.has_wipe_tower)
@@ -1934,10 +1959,11 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
     // The pipeline is variable: The vase mode filter is optional.
     const auto spiral_vase = tbb::make_filter<LayerResult, LayerResult>(
         slic3r_tbb_filtermode::serial_in_order,
-        [spiral_vase = this->m_spiral_vase.get(), &layers_to_print](LayerResult in) -> LayerResult
+        [spiral_vase = this->m_spiral_vase.get(), &print, &layers_to_print](LayerResult in) -> LayerResult
         {
             if (in.nop_layer_result)
                 return in;
+            PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.spiral_vase", 1);
             spiral_vase->enable(in.spiral_vase_enable);
             bool last_layer = in.layer_id == layers_to_print.size() - 1;
             return {spiral_vase->process_layer(std::move(in.gcode), last_layer), in.layer_id, in.spiral_vase_enable,
@@ -1945,41 +1971,52 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
         });
     const auto pressure_equalizer = tbb::make_filter<LayerResult, LayerResult>(
         slic3r_tbb_filtermode::serial_in_order,
-        [pressure_equalizer = this->m_pressure_equalizer.get()](LayerResult in) -> LayerResult
-        { return pressure_equalizer->process_layer(std::move(in)); });
-    const auto arc_handler = tbb::make_filter<LayerResult, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
-                                                                        [this](LayerResult in) -> LayerResult
-                                                                        {
-                                                                            if (in.nop_layer_result)
-                                                                                return in;
-
-                                                                            return in;
-                                                                        });
-    const auto cooling = tbb::make_filter<LayerResult, std::string>(
+        [pressure_equalizer = this->m_pressure_equalizer.get(), &print](LayerResult in) -> LayerResult
+        {
+            PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.pressure_equalizer", 1);
+            return pressure_equalizer->process_layer(std::move(in));
+        });
+    // The cooling buffer is split into two serial stages, so that the parsing of a layer overlaps
+    // with applying the slow down of the previous one.
+    const auto cooling_parse = tbb::make_filter<LayerResult, CoolingBuffer::ParsedLayer>(
         slic3r_tbb_filtermode::serial_in_order,
-        [cooling_buffer = this->m_cooling_buffer.get()](LayerResult in) -> std::string
+        [cooling_buffer = this->m_cooling_buffer.get(), &print](LayerResult in) -> CoolingBuffer::ParsedLayer
         {
             if (in.nop_layer_result)
-                return in.gcode;
-
-            return cooling_buffer->process_layer(std::move(in.gcode), in.layer_id, in.cooling_buffer_flush);
+                return {};
+            PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.cooling_parse", 1);
+            return cooling_buffer->parse_layer(std::move(in.gcode), std::move(in.moves), in.layer_id,
+                                               in.cooling_buffer_flush);
         });
-    const auto find_replace = tbb::make_filter<std::string, std::string>(
+    const auto cooling_apply = tbb::make_filter<CoolingBuffer::ParsedLayer, std::string>(
         slic3r_tbb_filtermode::serial_in_order,
-        [find_replace = this->m_find_replace.get()](std::string s) -> std::string
-        { return find_replace->process_layer(std::move(s)); });
+        [cooling_buffer = this->m_cooling_buffer.get(), &print](CoolingBuffer::ParsedLayer in) -> std::string
+        {
+            PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.cooling_apply", 1);
+            return cooling_buffer->apply_layer(std::move(in));
+        });
+    const auto find_replace = tbb::make_filter<std::string, std::string>(
+        slic3r_tbb_filtermode::parallel,
+        [find_replace = this->m_find_replace.get(), &print](std::string s) -> std::string
+        {
+            PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.find_replace", 1);
+            return find_replace->process_layer(std::move(s));
+        });
     const auto output = tbb::make_filter<std::string, void>(slic3r_tbb_filtermode::serial_in_order,
-                                                            [&output_stream](std::string s)
-                                                            { output_stream.write(s); });
-
-    tbb::filter<void, LayerResult> pipeline_to_layerresult = smooth_path_interpolator & generator;
+                                                            [&output_stream, &print](std::string s)
+                                                            {
+                                                                PrintTelemetry::Scope telemetry(print.telemetry(),
+                                                                                                "gcode.output", 1);
+                                                                output_stream.write(s);
+                                                            });
+
+    tbb::filter<void, LayerResult> pipeline_to_layerresult = layer_input & smooth_path_interpolator & generator;
     if (m_spiral_vase)
         pipeline_to_layerresult = pipeline_to_layerresult & spiral_vase;
     if (m_pressure_equalizer)
         pipeline_to_layerresult = pipeline_to_layerresult & pressure_equalizer;
-    pipeline_to_layerresult = pipeline_to_layerresult & arc_handler;
 
-    tbb::filter<LayerResult, std::string> pipeline_to_string = cooling;
+    tbb::filter<LayerResult, std::string> pipeline_to_string = cooling_parse & cooling_apply;
     if (m_find_replace)
         pipeline_to_string = pipeline_to_string & find_replace;
 
@@ -1988,7 +2025,11 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
     TBBLocalesSetter locales_setter;
     // The pipeline elements are joined using const references, thus no copying is performed.
     output_stream.find_replace_supress();
-    tbb::parallel_pipeline(12, pipeline_to_layerresult & pipeline_to_string & output);
+    {
+        PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.process_layers", layers_to_print.size(),
+                                        PrintTelemetry::CpuTime::Process);
+        tbb::parallel_pipeline(12, pipeline_to_layerresult & pipeline_to_string & output);
+    }
     output_stream.find_replace_enable();
 }
 
@@ -2003,10 +2044,10 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
     size_t layer_to_print_idx = 0;
     const GCode::SmoothPathCache::InterpolationParameters interpolation_params = interpolation_parameters(
         print.config());
-    const auto smooth_path_interpolator = tbb::make_filter<void, std::pair<size_t, GCode::SmoothPathCache>>(
+    const auto layer_input = tbb::make_filter<void, std::pair<size_t, GCode::SmoothPathCache>>(
         slic3r_tbb_filtermode::serial_in_order,
-        [this, &print, &layers_to_print, &layer_to_print_idx,
-         interpolation_params](tbb::flow_control &fc) -> std::pair<size_t, GCode::SmoothPathCache>
+        [this, &print, &layers_to_print,
+         &layer_to_print_idx](tbb::flow_control &fc) -> std::pair<size_t, GCode::SmoothPathCache>
         {
             if (layer_to_print_idx >= layers_to_print.size())
             {
@@ -2033,11 +2074,24 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
                     int progress = 33 + static_cast<int>(((idx + 1) * 17.0) / layers_to_print.size());
                     const_cast<Print &>(print).set_status(progress, _u8L("Generating G-code layers"));
                 }
-                GCode::SmoothPathCache smooth_path_cache;
-                GCodeGenerator::smooth_path_interpolate(layers_to_print[idx], interpolation_params, smooth_path_cache);
-                return {idx, std::move(smooth_path_cache)};
+                return {idx, {}};
             }
         });
+    // Arc fitting of a layer does not depend on the other layers, thus the layers are interpolated in parallel.
+    const auto smooth_path_interpolator =
+        tbb::make_filter<std::pair<size_t, GCode::SmoothPathCache>, std::pair<size_t, GCode::SmoothPathCache>>(
+            slic3r_tbb_filtermode::parallel,
+            [&print, &layers_to_print, &interpolation_params](
+                std::pair<size_t, GCode::SmoothPathCache> in) -> std::pair<size_t, GCode::SmoothPathCache>
+            {
+                if (in.first < layers_to_print.size())
+                {
+                    PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.smooth_path_interpolate", 1);
+                    print.throw_if_canceled();
+                    GCodeGenerator::smooth_path_interpolate(layers_to_print[in.first], interpolation_params, in.second);
+                }
+                return in;
+            });
     const auto generator = tbb::make_filter<std::pair<size_t, GCode::SmoothPathCache>, LayerResult>(
         slic3r_tbb_filtermode::serial_in_order,
         [this, &print, &tool_ordering, &layers_to_print, &smooth_path_cache_global,
@@ -2052,6 +2106,7 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
             }
             else
             {
+                PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.generate", 1);
                 ObjectLayerToPrint &layer = layers_to_print[layer_to_print_idx];
                 print.throw_if_canceled();
                 return this->process_layer(print, {std::move(layer)}, tool_ordering.tools_for_layer(layer.print_z()),
@@ -2062,10 +2117,11 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
     // The pipeline is variable: The vase mode filter is optional.
     const auto spiral_vase = tbb::make_filter<LayerResult, LayerResult>(
         slic3r_tbb_filtermode::serial_in_order,
-        [spiral_vase = this->m_spiral_vase.get(), &layers_to_print](LayerResult in) -> LayerResult
+        [spiral_vase = this->m_spiral_vase.get(), &print, &layers_to_print](LayerResult in) -> LayerResult
         {
             if (in.nop_layer_result)
                 return in;
+            PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.spiral_vase", 1);
             spiral_vase->enable(in.spiral_vase_enable);
             bool last_layer = in.layer_id == layers_to_print.size() - 1;
             return {spiral_vase->process_layer(std::move(in.gcode), last_layer), in.layer_id, in.spiral_vase_enable,
@@ -2073,40 +2129,52 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
         });
     const auto pressure_equalizer = tbb::make_filter<LayerResult, LayerResult>(
         slic3r_tbb_filtermode::serial_in_order,
-        [pressure_equalizer = this->m_pressure_equalizer.get()](LayerResult in) -> LayerResult
-        { return pressure_equalizer->process_layer(std::move(in)); });
-    const auto arc_handler = tbb::make_filter<LayerResult, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
-                                                                        [this](LayerResult in) -> LayerResult
-                                                                        {
-                                                                            if (in.nop_layer_result)
-                                                                                return in;
-
-                                                                            return in;
-                                                                        });
-    const auto cooling = tbb::make_filter<LayerResult, std::string>(
+        [pressure_equalizer = this->m_pressure_equalizer.get(), &print](LayerResult in) -> LayerResult
+        {
+            PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.pressure_equalizer", 1);
+            return pressure_equalizer->process_layer(std::move(in));
+        });
+    // The cooling buffer is split into two serial stages, so that the parsing of a layer overlaps
+    // with applying the slow down of the previous one.
+    const auto cooling_parse = tbb::make_filter<LayerResult, CoolingBuffer::ParsedLayer>(
         slic3r_tbb_filtermode::serial_in_order,
-        [cooling_buffer = this->m_cooling_buffer.get()](LayerResult in) -> std::string
+        [cooling_buffer = this->m_cooling_buffer.get(), &print](LayerResult in) -> CoolingBuffer::ParsedLayer
         {
             if (in.nop_layer_result)
-                return in.gcode;
-            return cooling_buffer->process_layer(std::move(in.gcode), in.layer_id, in.cooling_buffer_flush);
+                return {};
+            PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.cooling_parse", 1);
+            return cooling_buffer->parse_layer(std::move(in.gcode), std::move(in.moves), in.layer_id,
+                                               in.cooling_buffer_flush);
         });
-    const auto find_replace = tbb::make_filter<std::string, std::string>(
+    const auto cooling_apply = tbb::make_filter<CoolingBuffer::ParsedLayer, std::string>(
         slic3r_tbb_filtermode::serial_in_order,
-        [find_replace = this->m_find_replace.get()](std::string s) -> std::string
-        { return find_replace->process_layer(std::move(s)); });
+        [cooling_buffer = this->m_cooling_buffer.get(), &print](CoolingBuffer::ParsedLayer in) -> std::string
+        {
+            PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.cooling_apply", 1);
+            return cooling_buffer->apply_layer(std::move(in));
+        });
+    const auto find_replace = tbb::make_filter<std::string, std::string>(
+        slic3r_tbb_filtermode::parallel,
+        [find_replace = this->m_find_replace.get(), &print](std::string s) -> std::string
+        {
+            PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.find_replace", 1);
+            return find_replace->process_layer(std::move(s));
+        });
     const auto output = tbb::make_filter<std::string, void>(slic3r_tbb_filtermode::serial_in_order,
-                                                            [&output_stream](std::string s)
-                                                            { output_stream.write(s); });
-
-    tbb::filter<void, LayerResult> pipeline_to_layerresult = smooth_path_interpolator & generator;
+                                                            [&output_stream, &print](std::string s)
+                                                            {
+                                                                PrintTelemetry::Scope telemetry(print.telemetry(),
+                                                                                                "gcode.output", 1);
+                                                                output_stream.write(s);
+                                                            });
+
+    tbb::filter<void, LayerResult> pipeline_to_layerresult = layer_input & smooth_path_interpolator & generator;
     if (m_spiral_vase)
         pipeline_to_layerresult = pipeline_to_layerresult & spiral_vase;
     if (m_pressure_equalizer)
         pipeline_to_layerresult = pipeline_to_layerresult & pressure_equalizer;
-    pipeline_to_layerresult = pipeline_to_layerresult & arc_handler;
 
-    tbb::filter<LayerResult, std::string> pipeline_to_string = cooling;
+    tbb::filter<LayerResult, std::string> pipeline_to_string = cooling_parse & cooling_apply;
     if (m_find_replace)
         pipeline_to_string = pipeline_to_string & find_replace;
 
@@ -2115,7 +2183,11 @@ void GCodeGenerator::process_layers(const Print &print, const ToolOrdering &tool
     TBBLocalesSetter locales_setter;
     // The pipeline elements are joined using const references, thus no copying is performed.
     output_stream.find_replace_supress();
-    tbb::parallel_pipeline(12, pipeline_to_layerresult & pipeline_to_string & output);
+    {
+        PrintTelemetry::Scope telemetry(print.telemetry(), "gcode.process_layers", layers_to_print.size(),
+                                        PrintTelemetry::CpuTime::Process);
+        tbb::parallel_pipeline(12, pipeline_to_layerresult & pipeline_to_string & output);
+    }
     output_stream.find_replace_enable();
 }
 
@@ -3028,6 +3100,8 @@ LayerResult GCodeGenerator::process_layer(
     }
     const Layer &layer = (object_layer != nullptr) ? *object_layer : *support_layer;
     LayerResult result{{}, layer.id(), false, last_layer, false};
+    // Drop the moves formatted since the previous layer, they are not part of this layer's G-code.
+    m_layer_moves.clear();
 
     if (layer_tools.extruders.empty())
         // Nothing to extrude.
@@ -3379,6 +3453,8 @@ LayerResult GCodeGenerator::process_layer(
     BOOST_LOG_TRIVIAL(trace) << "Exported layer " << layer.id() << " print_z " << print_z << log_memory_info();
 
     result.gcode = std::move(gcode);
+    result.moves = std::move(m_layer_moves);
+    m_layer_moves.clear();
     result.cooling_buffer_flush = object_layer || raft_layer || last_layer;
     return result;
 }
@@ -28,6 +28,7 @@
 #include "libslic3r/GCode/AvoidCrossingPerimeters.hpp"
 #include "libslic3r/GCode/CoolingBuffer.hpp"
 #include "libslic3r/GCode/FindReplace.hpp"
+#include "libslic3r/GCode/GCodeMoves.hpp"
 #include "libslic3r/GCode/GCodeWriter.hpp"
 #include "libslic3r/GCode/LabelObjects.hpp"
 #include "libslic3r/GCode/PressureEqualizer.hpp"
@@ -95,6 +96,8 @@ struct LayerResult
     // Is indicating if this LayerResult should be processed, or it is just inserted artificial LayerResult.
     // It is used for the pressure equalizer because it needs to buffer one layer back.
     bool nop_layer_result{false};
+    // Moves of gcode formatted by GCodeWriter, empty if a filter rewrites the moves before the cooling buffer.
+    GCodeMoves moves;
 
     static LayerResult make_nop_layer_result() { return {"", std::numeric_limits<coord_t>::max(), false, false, true}; }
 };
@@ -432,6 +435,8 @@ private:
     std::optional<Vec3d> m_previous_layer_last_position_before_wipe;
     bool m_moved_to_first_layer_point{false};
 
+    // Moves formatted by m_writer for the layer being generated, passed to the cooling buffer with the layer.
+    GCodeMoves m_layer_moves;
     // This needs to be populated during the layer processing!
     std::unique_ptr<CoolingBuffer> m_cooling_buffer;
     std::unique_ptr<SpiralVase> m_spiral_vase;
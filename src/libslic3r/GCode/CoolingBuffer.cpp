@@ -28,8 +28,10 @@
 
 #include "../GCode.hpp"
 #include "libslic3r/GCode/CoolingBuffer.hpp"
+#include "libslic3r/GCode/GCodeMoves.hpp"
 #include "libslic3r/Extruder.hpp"
 #include "libslic3r/GCode/GCodeWriter.hpp"
+#include "libslic3r/GCodeReader.hpp"
 #include "libslic3r/Geometry/ArcWelder.hpp"
 #include "libslic3r/PrintConfig.hpp"
 #include "libslic3r/libslic3r.h"
@@ -48,7 +50,10 @@ namespace Slic3r
 const constexpr float SEGMENT_SPLIT_EPSILON = static_cast<float>(10.0 * GCodeFormatter::XYZ_EPSILON);
 
 CoolingBuffer::CoolingBuffer(GCodeGenerator &gcodegen)
-    : m_config(gcodegen.config()), m_toolchange_prefix(gcodegen.writer().toolchange_prefix()), m_current_extruder(0)
+    : m_config(gcodegen.config())
+    , m_toolchange_prefix(gcodegen.writer().toolchange_prefix())
+    , m_current_extruder(0)
+    , m_parsed_extruder(0)
 {
     this->reset(gcodegen.writer().get_position());
 
@@ -902,31 +907,50 @@ finished:
     return new_feedrate;
 }
 
-std::string CoolingBuffer::process_layer(std::string &&gcode, size_t layer_id, bool flush)
+CoolingBuffer::ParsedLayer::ParsedLayer() = default;
+CoolingBuffer::ParsedLayer::ParsedLayer(ParsedLayer &&) = default;
+CoolingBuffer::ParsedLayer::~ParsedLayer() = default;
+CoolingBuffer::ParsedLayer &CoolingBuffer::ParsedLayer::operator=(ParsedLayer &&) = default;
+
+CoolingBuffer::ParsedLayer CoolingBuffer::parse_layer(std::string &&gcode, GCodeMoves &&moves, size_t layer_id,
+                                                      bool flush)
 {
     // Cache the input G-code.
     if (m_gcode.empty())
         m_gcode = std::move(gcode);
     else
         m_gcode += gcode;
+    m_moves.append(std::move(moves));
 
-    std::string out;
+    ParsedLayer out;
     if (flush)
     {
         // This is either an object layer or the very last print layer. Calculate cool down over the collected support layers
         // and one object layer.
-        std::vector<PerExtruderAdjustments> per_extruder_adjustments = this->parse_layer_gcode(m_gcode, m_current_pos);
-        float layer_time_stretched = this->calculate_layer_slowdown(per_extruder_adjustments);
-        out = this->apply_layer_cooldown(m_gcode, layer_id, layer_time_stretched, per_extruder_adjustments);
+        const unsigned int layer_start_extruder = m_parsed_extruder;
+        out.per_extruder_adjustments = this->parse_layer_gcode(m_gcode, m_moves, m_current_pos, m_parsed_extruder);
+        out.layer_time = this->calculate_layer_slowdown(out.per_extruder_adjustments, layer_start_extruder);
+        out.gcode = std::move(m_gcode);
+        out.layer_id = layer_id;
+        out.flushed = true;
         m_gcode.clear();
+        m_moves.clear();
     }
     return out;
 }
 
+std::string CoolingBuffer::apply_layer(ParsedLayer &&layer)
+{
+    return layer.flushed ? this->apply_layer_cooldown(layer.gcode, layer.layer_id, layer.layer_time,
+                                                      layer.per_extruder_adjustments)
+                         : std::string();
+}
+
 // Parse the layer G-code for the moves, which could be adjusted.
 // Return the list of parsed lines, bucketed by an extruder.
-std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::string &gcode,
-                                                                     std::array<float, 5> &current_pos) const
+std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::string &gcode, GCodeMoves &moves,
+                                                                     std::array<float, 5> &current_pos,
+                                                                     unsigned int &current_extruder) const
 {
     std::vector<PerExtruderAdjustments> per_extruder_adjustments(m_extruder_ids.size());
     std::vector<size_t> map_extruder_to_per_extruder_adjustment(m_num_extruders, 0);
@@ -942,11 +966,11 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
         map_extruder_to_per_extruder_adjustment[extruder_id] = i;
     }
 
-    unsigned int current_extruder = m_current_extruder;
     PerExtruderAdjustments *adjustment =
         &per_extruder_adjustments[map_extruder_to_per_extruder_adjustment[current_extruder]];
     const char *line_start = gcode.c_str();
     const char *line_end = line_start;
+    const char *gcode_end = gcode.c_str() + gcode.size();
     const char extrusion_axis = get_extrusion_axis(m_config)[0];
     // Index of an existing CoolingLine of the current adjustment, which holds the feedrate setting command
     // for a sequence of extrusion moves.
@@ -955,8 +979,7 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
     std::array<float, AxisIdx::Count> new_pos;
     for (; *line_start != 0; line_start = line_end)
     {
-        while (*line_end != '\n' && *line_end != 0)
-            ++line_end;
+        line_end = GCodeReader::find_first_of(line_end, gcode_end, '\n', 0, 0);
         // sline will not contain the trailing '\n'.
         std::string_view sline(line_start, line_end - line_start);
         // CoolingLine will contain the trailing '\n'.
@@ -981,60 +1004,86 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
             // Initialize current_pos from new_pos, set IJKR to zero.
             std::fill(std::copy(std::begin(current_pos), std::end(current_pos), std::begin(new_pos)), std::end(new_pos),
                       0.f);
-            // Parse the G-code line.
-            for (auto c = sline.begin() + 3;;)
+            if (const GCodeMove *move = (line.type & CoolingLine::TYPE_G92) ? nullptr :
+                                            moves.find(std::string_view(line_start, line_end - line_start)))
             {
-                // Skip whitespaces.
-                for (; c != sline.end() && (*c == ' ' || *c == '\t'); ++c)
-                    ;
-                if (c == sline.end() || *c == ';')
-                    break;
-
-                // Parse the axis.
-                size_t axis = (*c >= 'X' && *c <= 'Z')   ? (*c - 'X')
-                              : (*c == extrusion_axis)   ? AxisIdx::E
-                              : (*c == 'F')              ? AxisIdx::F
-                              : (*c >= 'I' && *c <= 'K') ? int(AxisIdx::I) + (*c - 'I')
-                              : (*c == 'R')              ? AxisIdx::R
-                                                         : size_t(-1);
-                if (axis != size_t(-1))
+                // Formatted by GCodeWriter, take the axis values without parsing them.
+                static_assert(int(GCodeMove::Count) == int(AxisIdx::Count) && int(GCodeMove::R) == int(AxisIdx::R));
+                for (size_t axis = 0; axis < AxisIdx::Count; ++axis)
+                    if (move->has(GCodeMove::Axis(axis)))
+                        new_pos[axis] = move->values[axis];
+                if (move->has(GCodeMove::F))
                 {
-                    //auto [pend, ec] =
-                    fast_float::from_chars(&*(++c), sline.data() + sline.size(), new_pos[axis]);
-                    if (axis == AxisIdx::F)
+                    // Convert mm/min to mm/sec.
+                    new_pos[AxisIdx::F] /= 60.f;
+                    line.type |= CoolingLine::TYPE_HAS_F;
+                }
+                if (move->has(GCodeMove::I) || move->has(GCodeMove::J))
+                    line.type |= CoolingLine::TYPE_G2G3_IJ;
+                if (move->has(GCodeMove::R))
+                    line.type |= CoolingLine::TYPE_G2G3_R;
+            }
+            else
+            {
+                // Parse the G-code line.
+                for (auto c = sline.begin() + 3;;)
+                {
+                    // Skip whitespaces.
+                    for (; c != sline.end() && (*c == ' ' || *c == '\t'); ++c)
+                        ;
+                    if (c == sline.end() || *c == ';')
+                        break;
+
+                    // Parse the axis.
+                    size_t axis = (*c >= 'X' && *c <= 'Z')   ? (*c - 'X')
+                                  : (*c == extrusion_axis)   ? AxisIdx::E
+                                  : (*c == 'F')              ? AxisIdx::F
+                                  : (*c >= 'I' && *c <= 'K') ? int(AxisIdx::I) + (*c - 'I')
+                                  : (*c == 'R')              ? AxisIdx::R
+                                                             : size_t(-1);
+                    if (axis != size_t(-1))
                     {
-                        // Convert mm/min to mm/sec.
-                        new_pos[AxisIdx::F] /= 60.f;
-                        if ((line.type & CoolingLine::TYPE_G92) == 0)
-                            // This is G0 or G1 line and it sets the feedrate. This mark is used for reducing the duplicate F calls.
-                            line.type |= CoolingLine::TYPE_HAS_F;
+                        //auto [pend, ec] =
+                        fast_float::from_chars(&*(++c), sline.data() + sline.size(), new_pos[axis]);
+                        if (axis == AxisIdx::F)
+                        {
+                            // Convert mm/min to mm/sec.
+                            new_pos[AxisIdx::F] /= 60.f;
+                            if ((line.type & CoolingLine::TYPE_G92) == 0)
+                                // This is G0 or G1 line and it sets the feedrate. This mark is used for reducing the duplicate F calls.
+                                line.type |= CoolingLine::TYPE_HAS_F;
+                        }
+                        else if (axis >= AxisIdx::I && axis <= AxisIdx::J)
+                            line.type |= CoolingLine::TYPE_G2G3_IJ;
+                        else if (axis == AxisIdx::R)
+                            line.type |= CoolingLine::TYPE_G2G3_R;
                     }
-                    else if (axis >= AxisIdx::I && axis <= AxisIdx::J)
-                        line.type |= CoolingLine::TYPE_G2G3_IJ;
-                    else if (axis == AxisIdx::R)
-                        line.type |= CoolingLine::TYPE_G2G3_R;
+                    // Skip this word.
+                    for (; c != sline.end() && *c != ' ' && *c != '\t'; ++c)
+                        ;
                 }
-                // Skip this word.
-                for (; c != sline.end() && *c != ' ' && *c != '\t'; ++c)
-                    ;
             }
             // If G2 or G3, then either center of the arc or radius has to be defined.
             assert(!(line.type & CoolingLine::TYPE_G2G3) ||
                    (line.type & (CoolingLine::TYPE_G2G3_IJ | CoolingLine::TYPE_G2G3_R)));
             // Arc is defined either by IJ or by R, not by both.
             assert(!((line.type & CoolingLine::TYPE_G2G3_IJ) && (line.type & CoolingLine::TYPE_G2G3_R)));
-            bool external_perimeter = boost::contains(sline, ";_EXTERNAL_PERIMETER");
-            bool wipe = boost::contains(sline, ";_WIPE");
-            auto internal_perimeter_it_range = boost::find_last(sline, ";_INTERNAL_PERIMETER");
+            // All the tags start with ';', thus only the comment is searched. Most moves have no comment at all.
+            const std::string_view scomment = sline.substr(std::min(sline.find(';'), sline.size()));
+            bool external_perimeter = !scomment.empty() && boost::contains(scomment, ";_EXTERNAL_PERIMETER");
+            bool wipe = !scomment.empty() && boost::contains(scomment, ";_WIPE");
+            const std::string_view internal_perimeter_tag = ";_INTERNAL_PERIMETER";
+            const size_t internal_perimeter_pos = scomment.empty() ? std::string_view::npos
+                                                                   : scomment.rfind(internal_perimeter_tag);
             if (external_perimeter)
             {
                 line.type |= CoolingLine::TYPE_EXTERNAL_PERIMETER;
                 line.perimeter_index = 0;
             }
-            else if (!internal_perimeter_it_range.empty())
+            else if (internal_perimeter_pos != std::string_view::npos)
             {
                 uint16_t perimetr_index = 0;
-                const char *start_ptr = sline.data() + std::distance(sline.begin(), internal_perimeter_it_range.end());
+                const char *start_ptr = scomment.data() + internal_perimeter_pos + internal_perimeter_tag.size();
                 const char *end_ptr = sline.data() + sline.size();
                 const auto res = std::from_chars(start_ptr, end_ptr, perimetr_index);
                 if (res.ec == std::errc())
@@ -1047,7 +1096,7 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
 
             if (wipe)
                 line.type |= CoolingLine::TYPE_WIPE;
-            if (boost::contains(sline, ";_EXTRUDE_SET_SPEED") && !wipe)
+            if (!wipe && !scomment.empty() && boost::contains(scomment, ";_EXTRUDE_SET_SPEED"))
             {
                 line.type |= CoolingLine::TYPE_ADJUSTABLE;
                 active_speed_modifier = adjustment->lines.size();
@@ -1485,7 +1534,8 @@ static inline float extruder_range_slow_down_non_proportional(std::vector<PerExt
 }
 
 // Calculate slow down for all the extruders.
-float CoolingBuffer::calculate_layer_slowdown(std::vector<PerExtruderAdjustments> &per_extruder_adjustments)
+float CoolingBuffer::calculate_layer_slowdown(std::vector<PerExtruderAdjustments> &per_extruder_adjustments,
+                                              unsigned int current_extruder) const
 {
     // Sort the extruders by an increasing slowdown_below_layer_time.
     // The layers with a lower slowdown_below_layer_time are slowed down
@@ -1498,7 +1548,7 @@ float CoolingBuffer::calculate_layer_slowdown(std::vector<PerExtruderAdjustments
     for (PerExtruderAdjustments &adj : per_extruder_adjustments)
     {
         const double perimeter_transition_distance = m_config.cooling_perimeter_transition_distance.get_at(
-            m_current_extruder);
+            current_extruder);
         if (adj.cooling_slowdown_logic == CoolingSlowdownLogicType::ConsistentSurface &&
             perimeter_transition_distance >= 0.)
         {
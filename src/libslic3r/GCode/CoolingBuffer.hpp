@@ -22,6 +22,7 @@
 #include "libslic3r/libslic3r.h"
 #include "libslic3r/Point.hpp"
 #include "FanRampEstimator.hpp"
+#include "GCodeMoves.hpp"
 
 namespace Slic3r
 {
@@ -45,18 +46,51 @@ class CoolingBuffer
 public:
     CoolingBuffer(GCodeGenerator &gcodegen);
     void reset(const Vec3d &position);
-    void set_current_extruder(unsigned int extruder_id) { m_current_extruder = extruder_id; }
-    std::string process_layer(std::string &&gcode, size_t layer_id, bool flush);
+    void set_current_extruder(unsigned int extruder_id)
+    {
+        m_current_extruder = extruder_id;
+        m_parsed_extruder = extruder_id;
+    }
+    std::string process_layer(std::string &&gcode, size_t layer_id, bool flush)
+    {
+        return this->apply_layer(this->parse_layer(std::move(gcode), GCodeMoves(), layer_id, flush));
+    }
     std::string process_layer(const std::string &gcode, size_t layer_id, bool flush)
     {
         return this->process_layer(std::string(gcode), layer_id, flush);
     }
 
+    // A layer parsed and with its slow down calculated, waiting for apply_layer().
+    struct ParsedLayer
+    {
+        ParsedLayer();
+        ParsedLayer(ParsedLayer &&);
+        ~ParsedLayer();
+        ParsedLayer &operator=(ParsedLayer &&);
+
+        std::string gcode;
+        size_t layer_id{0};
+        float layer_time{0.f};
+        std::vector<PerExtruderAdjustments> per_extruder_adjustments;
+        // False if the G-code was cached to be processed together with the following layer.
+        bool flushed{false};
+    };
+    // process_layer() split into two steps, which keep their own state over the layers. Thus for each layer
+    // the two steps may run concurrently with the other step of a neighbor layer, for example as two
+    // serial stages of a pipeline.
+    // Collect the layer G-code, parse it and calculate the slow down.
+    // The axis values of the lines found in moves are taken from there instead of being parsed.
+    ParsedLayer parse_layer(std::string &&gcode, GCodeMoves &&moves, size_t layer_id, bool flush);
+    // Apply the slow down and emit the fan commands. Returns the adjusted G-code.
+    std::string apply_layer(ParsedLayer &&layer);
+
 private:
     CoolingBuffer &operator=(const CoolingBuffer &) = delete;
-    std::vector<PerExtruderAdjustments> parse_layer_gcode(const std::string &gcode,
-                                                          std::array<float, 5> &current_pos) const;
-    float calculate_layer_slowdown(std::vector<PerExtruderAdjustments> &per_extruder_adjustments);
+    std::vector<PerExtruderAdjustments> parse_layer_gcode(const std::string &gcode, GCodeMoves &moves,
+                                                          std::array<float, 5> &current_pos,
+                                                          unsigned int &current_extruder) const;
+    float calculate_layer_slowdown(std::vector<PerExtruderAdjustments> &per_extruder_adjustments,
+                                   unsigned int current_extruder) const;
     // Apply slow down over G-code lines stored in per_extruder_adjustments, enable fan if needed.
     // Returns the adjusted G-code.
     std::string apply_layer_cooldown(const std::string &gcode, size_t layer_id, float layer_time,
@@ -64,6 +98,8 @@ private:
 
     // G-code snippet cached for the support layers preceding an object layer.
     std::string m_gcode;
+    // Moves of m_gcode formatted by GCodeWriter.
+    GCodeMoves m_moves;
     // Internal data.
     std::vector<char> m_axis;
     enum AxisIdx : int
@@ -91,7 +127,10 @@ private:
     // Referencs GCodeGenerator::m_config, which is FullPrintConfig. While the PrintObjectConfig slice of FullPrintConfig is being modified,
     // the PrintConfig slice of FullPrintConfig is constant, thus no thread synchronization is required.
     const PrintConfig &m_config;
+    // Extruder at the position of apply_layer().
     unsigned int m_current_extruder;
+    // Extruder at the end of the last layer processed by parse_layer().
+    unsigned int m_parsed_extruder;
 
     // Per-extruder fan ramp estimators, initialized from printer config
     std::vector<FanRampEstimator> m_fan_ramp_estimators;
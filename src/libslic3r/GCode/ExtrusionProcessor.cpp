@@ -147,8 +147,7 @@ ExtrusionEntityCollection calculate_and_split_overhanging_extrusions(
         }
         else if (auto *loop = dynamic_cast<const ExtrusionLoop *>(e))
         {
-            ExtrusionLoop new_loop = *loop;
-            new_loop.paths.clear();
+            ExtrusionLoop new_loop(loop->loop_role());
 
             ExtrusionPaths paths{loop->paths};
             if (!paths.empty())
@@ -176,34 +175,35 @@ ExtrusionEntityCollection calculate_and_split_overhanging_extrusions(
             {
                 auto resulting_paths = calculate_and_split_overhanging_extrusions(p, unscaled_prev_layer,
                                                                                   prev_layer_curled_lines);
-                new_loop.paths.insert(new_loop.paths.end(), resulting_paths.begin(), resulting_paths.end());
+                new_loop.paths.insert(new_loop.paths.end(), std::make_move_iterator(resulting_paths.begin()),
+                                      std::make_move_iterator(resulting_paths.end()));
             }
-            result.append(new_loop);
+            result.append(std::move(new_loop));
         }
         else if (auto *mp = dynamic_cast<const ExtrusionMultiPath *>(e))
         {
-            ExtrusionMultiPath new_mp = *mp;
-            new_mp.paths.clear();
+            ExtrusionMultiPath new_mp;
             for (const ExtrusionPath &p : mp->paths)
             {
                 auto paths = calculate_and_split_overhanging_extrusions(p, unscaled_prev_layer,
                                                                         prev_layer_curled_lines);
-                new_mp.paths.insert(new_mp.paths.end(), paths.begin(), paths.end());
+                new_mp.paths.insert(new_mp.paths.end(), std::make_move_iterator(paths.begin()),
+                                    std::make_move_iterator(paths.end()));
             }
-            result.append(new_mp);
+            result.append(std::move(new_mp));
         }
         else if (auto *op = dynamic_cast<const ExtrusionPathOriented *>(e))
         {
             auto paths = calculate_and_split_overhanging_extrusions(*op, unscaled_prev_layer, prev_layer_curled_lines);
-            for (const ExtrusionPath &p : paths)
+            for (ExtrusionPath &p : paths)
             {
-                result.append(ExtrusionPathOriented(p.polyline, p.attributes()));
+                result.append(ExtrusionPathOriented(std::move(p.polyline), p.attributes()));
             }
         }
         else if (auto *p = dynamic_cast<const ExtrusionPath *>(e))
         {
             auto paths = calculate_and_split_overhanging_extrusions(*p, unscaled_prev_layer, prev_layer_curled_lines);
-            result.append(paths);
+            result.append(std::move(paths));
         }
         else
         {
@@ -22,7 +22,8 @@ public:
     GCodeFindReplace(const PrintConfig &print_config) : GCodeFindReplace(print_config.gcode_substitutions.values) {}
     GCodeFindReplace(const std::vector<std::string> &gcode_substitutions);
 
-    std::string process_layer(const std::string &gcode);
+    // Thread safe, the layers may be processed concurrently.
+    std::string process_layer(const std::string &gcode) const;
 
 private:
     struct Substitution
@@ -0,0 +1,125 @@
+///|/ Copyright (c) preFlight 2025+ oozeBot, LLC
+///|/
+///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
+///|/
+#ifndef slic3r_GCodeMoves_hpp_
+#define slic3r_GCodeMoves_hpp_
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Slic3r
+{
+
+// G1, G2 or G3 line formatted by GCodeWriter, with its axis values equal to the values a G-code reader
+// parses from its text.
+struct GCodeMove
+{
+    enum Axis : uint8_t
+    {
+        X = 0,
+        Y,
+        Z,
+        E,
+        F,
+        I,
+        J,
+        K,
+        R,
+        Count
+    };
+
+    // Axes present on the line, bit mask indexed by Axis.
+    uint16_t axes{0};
+    std::array<float, Axis::Count> values{};
+    // Span of the line including its trailing '\n' in GCodeMoves::text().
+    uint32_t text_begin{0};
+    uint32_t text_end{0};
+
+    bool has(Axis axis) const { return (this->axes >> axis) & 1; }
+    void set(Axis axis, float value)
+    {
+        this->axes |= uint16_t(1 << axis);
+        this->values[axis] = value;
+    }
+};
+
+// Typed companion of the G-code of a layer: the moves formatted by GCodeWriter in the order they were formatted.
+// The G-code filters receiving the layer from the G-code generator look the move lines up here instead of parsing
+// their axis values again. A move is matched by its text, therefore a line emitted or modified by anything
+// else than GCodeWriter (custom G-code, wipe tower, vase mode) is just not found and has to be parsed.
+class GCodeMoves
+{
+public:
+    bool empty() const { return m_moves.empty(); }
+    const std::string &text() const { return m_text; }
+
+    void clear()
+    {
+        m_moves.clear();
+        m_text.clear();
+        m_next = 0;
+    }
+
+    // line includes the trailing '\n'.
+    void append(std::string_view line, GCodeMove move)
+    {
+        move.text_begin = uint32_t(m_text.size());
+        m_text += line;
+        move.text_end = uint32_t(m_text.size());
+        m_moves.emplace_back(move);
+    }
+
+    void append(GCodeMoves &&rhs)
+    {
+        if (m_moves.empty())
+        {
+            *this = std::move(rhs);
+            return;
+        }
+        const uint32_t offset = uint32_t(m_text.size());
+        m_text += rhs.m_text;
+        m_moves.reserve(m_moves.size() + rhs.m_moves.size());
+        for (GCodeMove move : rhs.m_moves)
+        {
+            move.text_begin += offset;
+            move.text_end += offset;
+            m_moves.emplace_back(move);
+        }
+        rhs.clear();
+    }
+
+    // Find the move formatted as line, which includes its trailing '\n'. The lines are expected to be looked up
+    // in the order they were formatted: the search starts after the last move found and it skips at most
+    // a few moves, which were formatted, but not emitted into the G-code.
+    const GCodeMove *find(std::string_view line)
+    {
+        static constexpr size_t max_skipped = 16;
+        for (size_t i = m_next; i < m_moves.size() && i <= m_next + max_skipped; ++i)
+        {
+            const GCodeMove &move = m_moves[i];
+            if (move.text_end - move.text_begin == line.size() &&
+                std::memcmp(m_text.data() + move.text_begin, line.data(), line.size()) == 0)
+            {
+                m_next = i + 1;
+                return &move;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    std::vector<GCodeMove> m_moves;
+    std::string m_text;
+    // Index of the move to start the next find() with.
+    size_t m_next{0};
+};
+
+} // namespace Slic3r
+
+#endif // slic3r_GCodeMoves_hpp_
@@ -40,6 +40,7 @@
 #include <cmath>
 #include <sstream>
 #include <limits>
+#include <memory>
 
 static const float DEFAULT_TOOLPATH_WIDTH = 0.4f;
 static const float DEFAULT_TOOLPATH_HEIGHT = 0.2f;
@@ -470,13 +471,13 @@ void GCodeProcessor::TimeMachine::calculate_time(GCodeProcessorResult &result, P
         // detect actual speed moves required to render toolpaths using actual speed
         if (mode == PrintEstimatedStatistics::ETimeMode::Normal)
         {
-            GCodeProcessorResult::MoveVertex &curr_move = result.moves[block.move_id];
+            GCodeProcessorResult::MoveVertices::Ref curr_move = result.moves[block.move_id];
             if (curr_move.type == EMoveType::Extrude || curr_move.type == EMoveType::Travel ||
                 curr_move.type == EMoveType::Wipe)
             {
                 assert(curr_move.actual_feedrate == 0.0f);
 
-                GCodeProcessorResult::MoveVertex &prev_move = result.moves[block.move_id - 1];
+                GCodeProcessorResult::MoveVertices::Ref prev_move = result.moves[block.move_id - 1];
                 const bool interpolate = (prev_move.type == curr_move.type);
                 // Interlocking uses deliberate width transitions that should be instant, not tapered
                 const bool interlock_transition = (prev_move.extrusion_role ==
@@ -858,7 +859,7 @@ const std::vector<std::pair<GCodeProcessor::EProducer, std::string>> GCodeProces
     {EProducer::KissSlicer, "KISSlicer"},
     {EProducer::BambuStudio, "BambuStudio"}};
 
-unsigned int GCodeProcessor::s_result_id = 0;
+std::atomic<unsigned int> GCodeProcessor::s_result_id{0};
 
 bool GCodeProcessor::contains_reserved_tag(const std::string &gcode, std::string &found_tag)
 {
@@ -1622,6 +1623,7 @@ void GCodeProcessor::reset()
 
     m_time_processor.reset();
     m_used_filaments.reset();
+    m_last_progress = 50;
 
     // After extract_result(), m_result is in a moved-from state
     // We need to reconstruct it to ensure it's in a valid state
@@ -1653,31 +1655,18 @@ GCodeProcessorResult &&GCodeProcessor::extract_result()
         m_use_virtual_file = false;
     }
 
-    // Note: output_virtual_file is already set in post_process_virtual_file
+    // Note: output_virtual_file is already set in post_process()
 
     return std::move(m_result);
 }
 
-void GCodeProcessor::post_process_virtual_file()
+void GCodeProcessor::process_virtual_file()
 {
-    if (!m_virtual_file)
-    {
-        printf("ERROR: post_process_virtual_file called with no virtual file\n");
-        return;
-    }
-
-    // Create output virtual file
-    VirtualGCodeFile *output_vf = new VirtualGCodeFile();
-    output_vf->reserve_lines(m_virtual_file->line_count() * 1.1); // +10% for M73
+    assert(m_virtual_file != nullptr);
 
     // Initialize moves for rendering - CRITICAL!
     initialize_result_moves();
     m_line_id = 0; // Will be incremented to 1 on first line
-    size_t g1_lines_counter = 0;
-
-    // Clear and initialize lines_ends for virtual file
-    m_result.lines_ends.clear();
-    m_result.lines_ends.emplace_back(std::vector<size_t>());
 
     // The machine limits (from RRF M203, M201, etc.) and acceleration values (from M204)
     // were set during apply_config(). TimeProcessor::reset() would wipe them with defaults.
@@ -1712,6 +1701,7 @@ void GCodeProcessor::post_process_virtual_file()
 
     // Initialize time estimation
     m_time_processor.reset();
+    m_last_progress = 50;
 
     // Restore the machine envelope settings that were configured for this print
     m_time_processor.machine_limits = saved_machine_limits;
@@ -1731,199 +1721,37 @@ void GCodeProcessor::post_process_virtual_file()
     }
     // Note: simulate_st_synchronize behavior is handled in the processor, not individual machines
 
-    // Calculate filament statistics
-    std::vector<double> filament_mm(m_result.extruders_count, 0.0);
-    std::vector<double> filament_cm3(m_result.extruders_count, 0.0);
-    std::vector<double> filament_g(m_result.extruders_count, 0.0);
-    std::vector<double> filament_cost(m_result.extruders_count, 0.0);
-
-    double filament_total_g = 0.0;
-    double filament_total_cost = 0.0;
-
-    for (const auto &[id, volume] : m_result.print_statistics.volumes_per_extruder)
-    {
-        filament_mm[id] = volume / (static_cast<double>(M_PI) * sqr(0.5 * m_result.filament_diameters[id]));
-        filament_cm3[id] = volume * 0.001;
-        filament_g[id] = filament_cm3[id] * double(m_result.filament_densities[id]);
-        filament_cost[id] = filament_g[id] * double(m_result.filament_cost[id]) * 0.001;
-        filament_total_g += filament_g[id];
-        filament_total_cost += filament_cost[id];
-    }
-
-    // Lambda functions for time formatting and M73 lines
-    auto time_in_minutes = [](float time_in_seconds)
-    {
-        assert(time_in_seconds >= 0.f);
-        return int((time_in_seconds + 0.5f) / 60.0f);
-    };
-
-    auto format_line_M73_main = [](const std::string &mask, int percent, int time)
+    // Parse the G-code lines in place in the buffer of the virtual file to generate moves.
+    // The lines are split the same way post_process() splits them, so that the gcode ids of the moves
+    // match the line ids used by post_process() to synchronize the moves with the exported G-code.
+    GCodeReader parser;
+    GCodeReader::GCodeLine gline;
+    auto process_line = [this](GCodeReader &reader, const GCodeReader::GCodeLine &line)
     {
-        char line_M73[64];
-        sprintf(line_M73, mask.c_str(), std::to_string(percent).c_str(), std::to_string(time).c_str());
-        return std::string(line_M73);
+        this->process_gcode_line(line, true);
     };
-
-    // Track last exported M73 values to avoid duplicates
-    std::array<std::pair<int, int>, static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count)> last_exported_main;
-    for (size_t i = 0; i < last_exported_main.size(); ++i)
-    {
-        last_exported_main[i] = {0, time_in_minutes(m_time_processor.machines[i].time)};
-    }
-
-    // Iterators for time cache
-    auto g1_times_cache_it = Slic3r::reserve_vector<std::vector<TimeMachine::G1LinesCacheItem>::const_iterator>(
-        m_time_processor.machines.size());
-    for (const auto &machine : m_time_processor.machines)
-        g1_times_cache_it.emplace_back(machine.g1_times_cache.begin());
-
-    // Lambda to insert M73 progress
-    auto insert_m73 = [&](size_t g1_counter)
+    const std::string &buffer = m_virtual_file->get_buffer();
+    const char *ptr = buffer.data();
+    const char *end = ptr + buffer.size();
+    for (size_t line_idx = 0; ptr != end; ++line_idx)
     {
-        if (m_time_processor.export_remaining_time_enabled)
-        {
-            for (size_t i = 0; i < static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count); ++i)
-            {
-                const TimeMachine &machine = m_time_processor.machines[i];
-                if (machine.enabled)
-                {
-                    // Skip to current position in cache
-                    auto &it = g1_times_cache_it[i];
-                    while (it != machine.g1_times_cache.end() && it->id < g1_counter)
-                        ++it;
-                    if (it != machine.g1_times_cache.end() && it->id == g1_counter)
-                    {
-                        std::pair<int, int> to_export_main = {int(100.0f * it->elapsed_time / machine.time),
-                                                              time_in_minutes(machine.time - it->elapsed_time)};
-                        if (last_exported_main[i] != to_export_main)
-                        {
-                            const std::string &line_M73 = format_line_M73_main(machine.line_m73_main_mask.c_str(),
-                                                                               to_export_main.first,
-                                                                               to_export_main.second);
-                            output_vf->write_line(line_M73);
-                            last_exported_main[i] = to_export_main;
-                        }
-                    }
-                }
-            }
-        }
-    };
-
-    // CRITICAL: Parse G-code to generate moves!
-    GCodeReader parser;
-
-    // Parse G-code to generate moves
-
-    for (size_t line_idx = 0; line_idx < m_virtual_file->line_count(); ++line_idx)
-    {
-        std::string line = m_virtual_file->get_line(line_idx);
-
-        // Remove trailing newline for parser
-        if (!line.empty() && line.back() == '\n')
-        {
-            line.pop_back();
-        }
-        if (!line.empty() && line.back() == '\r')
-        {
-            line.pop_back();
-        }
-
+        const char *line_end = GCodeReader::find_eol(ptr, end);
         // Set m_line_id to line_idx (0-based) so that after process_gcode_line
         // increments it with ++m_line_id, it becomes the correct 1-based line number.
         // This ensures store_move_vertex gets the correct gcode_id for the G1 command.
         m_line_id = line_idx;
-
-        // Parse line to generate moves
-        parser.parse_line(line,
-                          [&](GCodeReader &reader, const GCodeReader::GCodeLine &gline)
-                          {
-                              // Save current line ID AFTER increment happens inside process_gcode_line
-                              // We need to save/restore to prevent the outer loop from seeing the increment
-
-                              // CRITICAL: This generates the move vertices!
-                              this->process_gcode_line(gline, true);
-
-                              // After process_gcode_line, m_line_id has been incremented to line_idx + 1
-                              // We don't need to restore it since the outer loop will set it fresh next iteration
-
-                              // Track G1/G0 for M73 insertion
-                              if (gline.cmd_is("G1") || gline.cmd_is("G0"))
-                              {
-                                  // Check if M73 needed after this move
-                                  insert_m73(g1_lines_counter);
-                                  g1_lines_counter++;
-                              }
-                          });
-
-        // Check for placeholders and replace them with actual values
-        // Placeholder format in G-code: ";_GP_ESTIMATED_PRINTING_TIME_PLACEHOLDER"
-        // We need to skip the leading semicolon when comparing
-        bool placeholder_processed = false;
-        std::string_view line_view(line);
-        if (line_view.length() > 1 && line_view[0] == ';')
-        {
-            line_view = line_view.substr(1); // Skip the semicolon
-        }
-
-        if (line_view == reserved_tag(ETags::Estimated_Printing_Time_Placeholder))
-        {
-            // Replace placeholder with actual estimated printing time
-            for (size_t i = 0; i < static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count); ++i)
-            {
-                const TimeMachine &machine = m_time_processor.machines[i];
-                PrintEstimatedStatistics::ETimeMode mode = static_cast<PrintEstimatedStatistics::ETimeMode>(i);
-                if (mode == PrintEstimatedStatistics::ETimeMode::Normal || machine.enabled)
-                {
-                    char buf[128];
-                    sprintf(buf, "; estimated printing time (%s mode) = %s\n",
-                            (mode == PrintEstimatedStatistics::ETimeMode::Normal) ? "normal" : "silent",
-                            get_time_dhms(machine.time).c_str());
-                    output_vf->write_line(buf);
-                }
-            }
-            // Also write first layer time
-            for (size_t i = 0; i < static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count); ++i)
-            {
-                const TimeMachine &machine = m_time_processor.machines[i];
-                PrintEstimatedStatistics::ETimeMode mode = static_cast<PrintEstimatedStatistics::ETimeMode>(i);
-                if (mode == PrintEstimatedStatistics::ETimeMode::Normal || machine.enabled)
-                {
-                    char buf[128];
-                    sprintf(buf, "; estimated first layer printing time (%s mode) = %s\n",
-                            (mode == PrintEstimatedStatistics::ETimeMode::Normal) ? "normal" : "silent",
-                            get_time_dhms(machine.first_layer_time).c_str());
-                    output_vf->write_line(buf);
-                }
-            }
-            placeholder_processed = true;
-        }
-
-        // Write original line to output (with newline) if not a placeholder
-        if (!placeholder_processed)
-        {
-            output_vf->write_line(line + "\n");
-        }
-    }
-
-    // Moves generated successfully
-
-    // Store output in result
-    m_result.output_virtual_file = output_vf;
-    m_result.owns_output_virtual_file = true;
-
-    // Populate lines_ends for compatibility with libvgcode
-    // Each entry is the cumulative character position after each line
-    size_t cumulative_pos = 0;
-    for (size_t i = 0; i < output_vf->line_count(); ++i)
-    {
-        std::string line = output_vf->get_line(i);
-        cumulative_pos += line.length();
-        m_result.lines_ends.front().push_back(cumulative_pos);
+        gline.reset();
+        parser.parse_line(ptr, line_end, gline, process_line);
+        // Skip EOL.
+        ptr = line_end;
+        if (ptr != end && *ptr == '\r')
+            ++ptr;
+        if (ptr != end && *ptr == '\n')
+            ++ptr;
     }
 
-    // lines_ends populated successfully
-
     // Must call finalize() to process accumulated filament data into print statistics
+    // and to calculate the final times, which post_process() needs to export the lines M73.
     // Without this, legend shows 0.00 for all values because used_filaments_per_role is empty
     this->finalize(false);
 }
@@ -2020,7 +1848,7 @@ void GCodeProcessor::process_ascii_file(const std::string &filename, GCodeReader
     initialize_result_moves();
     size_t parse_line_callback_cntr = 10000;
     m_parser.set_progress_callback(progress_callback);
-    m_parser.parse_file(
+    m_parser.parse_file_parallel(
         filename,
         [this, cancel_callback, &parse_line_callback_cntr](GCodeReader &reader, const GCodeReader::GCodeLine &line)
         {
@@ -2249,7 +2077,7 @@ void GCodeProcessor::finalize(bool perform_post_process)
     m_result.z_offset = m_z_offset;
 
     // update width/height of wipe moves
-    for (GCodeProcessorResult::MoveVertex &move : m_result.moves)
+    for (GCodeProcessorResult::MoveVertices::Ref move : m_result.moves)
     {
         if (move.type == EMoveType::Wipe)
         {
@@ -2278,16 +2106,19 @@ void GCodeProcessor::finalize(bool perform_post_process)
 
         const size_t num_moves = m_result.moves.size();
         constexpr size_t NORMAL_MODE = static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Normal);
+        // The windows read just these columns of the moves.
+        const auto &times = m_result.moves.times();
+        const auto &layer_ids = m_result.moves.layer_ids();
+        const auto &types = m_result.moves.types();
+        const auto &extrusion_roles = m_result.moves.extrusion_roles();
 
         for (size_t i = 0; i < num_moves; i++)
         {
-            const auto &start_move = m_result.moves[i];
-
             // Skip moves with no time (non-motion commands)
-            if (start_move.time[NORMAL_MODE] <= 0.0f)
+            if (times[i][NORMAL_MODE] <= 0.0f)
                 continue;
 
-            unsigned int start_layer = start_move.layer_id;
+            unsigned int start_layer = layer_ids[i];
 
             // === OVERALL STATS: Count ALL commands in 1-second window ===
             // Note: 0-time segments are still commands the motion controller must process
@@ -2297,13 +2128,11 @@ void GCodeProcessor::finalize(bool perform_post_process)
 
                 for (size_t j = i; j < num_moves && accumulated_time < 1.0; j++)
                 {
-                    const auto &move = m_result.moves[j];
-
-                    if (move.layer_id != start_layer)
+                    if (layer_ids[j] != start_layer)
                         break;
 
                     // Accumulate time for window calculation
-                    float move_time = move.time[NORMAL_MODE];
+                    float move_time = times[j][NORMAL_MODE];
                     if (move_time > 0.0f)
                         accumulated_time += move_time;
 
@@ -2321,26 +2150,24 @@ void GCodeProcessor::finalize(bool perform_post_process)
             }
 
             // === PER-ROLE STATS: Only count commands of SAME role ===
-            if (start_move.type == EMoveType::Extrude)
+            if (types[i] == EMoveType::Extrude)
             {
                 double accumulated_time = 0.0;
                 size_t command_count = 0;
-                GCodeExtrusionRole start_role = start_move.extrusion_role;
+                GCodeExtrusionRole start_role = extrusion_roles[i];
 
                 for (size_t j = i; j < num_moves && accumulated_time < 1.0; j++)
                 {
-                    const auto &move = m_result.moves[j];
-
-                    if (move.layer_id != start_layer)
+                    if (layer_ids[j] != start_layer)
                         break;
 
                     // For per-role, count time from ALL moves but only count segments of same role
-                    float move_time = move.time[NORMAL_MODE];
+                    float move_time = times[j][NORMAL_MODE];
                     if (move_time > 0.0f)
                         accumulated_time += move_time;
 
                     // Only count if same role
-                    if (move.type == EMoveType::Extrude && move.extrusion_role == start_role)
+                    if (types[j] == EMoveType::Extrude && extrusion_roles[j] == start_role)
                         command_count++;
                 }
 
@@ -5452,23 +5279,38 @@ void GCodeProcessor::process_T(const std::string_view command)
 
 void GCodeProcessor::post_process()
 {
-    if (m_use_virtual_file && m_virtual_file)
+    // The G-code exported into a virtual file was not processed while exporting. Process it now, then export
+    // the final G-code into the output virtual file in a single pass over the buffer of the input virtual file.
+    // Only the lines within the backtrace time are kept in memory by ExportLines to insert the lines M73 / M104.
+    VirtualGCodeFile *in_vf = m_use_virtual_file ? m_virtual_file : nullptr;
+    if (in_vf != nullptr)
+        process_virtual_file();
+
+    FilePtr in{nullptr};
+    FilePtr out{nullptr};
+    // temporary file to contain modified gcode
+    std::string out_path;
+    std::unique_ptr<VirtualGCodeFile> out_vf;
+    if (in_vf != nullptr)
     {
-        post_process_virtual_file();
-        return;
+        out_vf = std::make_unique<VirtualGCodeFile>();
+        out_vf->reserve_lines(in_vf->line_count() * 1.1); // +10% for M73
     }
+    else
+    {
+        in.f = boost::nowide::fopen(m_result.filename.c_str(), "rb");
+        if (in.f == nullptr)
+            throw Slic3r::RuntimeError(
+                std::string("GCode processor post process export failed.\nCannot open file for reading.\n"));
 
-    FilePtr in{boost::nowide::fopen(m_result.filename.c_str(), "rb")};
-    if (in.f == nullptr)
-        throw Slic3r::RuntimeError(
-            std::string("GCode processor post process export failed.\nCannot open file for reading.\n"));
-
-    // temporary file to contain modified gcode
-    std::string out_path = m_result.filename + ".postprocess";
-    FilePtr out{boost::nowide::fopen(out_path.c_str(), "wb")};
-    if (out.f == nullptr)
-        throw Slic3r::RuntimeError(
-            std::string("GCode processor post process export failed.\nCannot open file for writing.\n"));
+        out_path = m_result.filename + ".postprocess";
+        out.f = boost::nowide::fopen(out_path.c_str(), "wb");
+        if (out.f == nullptr)
+            throw Slic3r::RuntimeError(
+                std::string("GCode processor post process export failed.\nCannot open file for writing.\n"));
+    }
+    // The virtual file is exported as ASCII G-code.
+    const bool binarize = out_vf == nullptr && m_binarizer.is_enabled();
 
     std::vector<double> filament_mm(m_result.extruders_count, 0.0);
     std::vector<double> filament_cm3(m_result.extruders_count, 0.0);
@@ -5490,7 +5332,7 @@ void GCodeProcessor::post_process()
 
     double total_g_wipe_tower = m_print->print_statistics().total_wipe_tower_filament_weight;
 
-    if (m_binarizer.is_enabled())
+    if (binarize)
     {
         // update print metadata
         auto stringify = [](const std::vector<double> &values)
@@ -5682,18 +5524,21 @@ void GCodeProcessor::post_process()
         size_t m_out_file_pos{0};
 
         bgcode::binarize::Binarizer &m_binarizer;
+        // If set, the lines are exported into this virtual file instead of the file or the binarizer.
+        VirtualGCodeFile *m_out_vf;
 
     public:
         ExportLines(
-            bgcode::binarize::Binarizer &binarizer, EWriteType type,
+            bgcode::binarize::Binarizer &binarizer, VirtualGCodeFile *out_vf, EWriteType type,
             const std::array<TimeMachine, static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count)> &machines)
 #ifndef NDEBUG
             : m_statistics(*this)
             , m_binarizer(binarizer)
+            , m_out_vf(out_vf)
             , m_write_type(type)
             , m_machines(machines){}
 #else
-            : m_binarizer(binarizer), m_write_type(type), m_machines(machines)
+            : m_binarizer(binarizer), m_out_vf(out_vf), m_write_type(type), m_machines(machines)
         {
         }
 #endif // NDEBUG
@@ -5862,16 +5707,7 @@ void GCodeProcessor::post_process()
                 }
             }
 
-            if (m_binarizer.is_enabled())
-            {
-                if (m_binarizer.append_gcode(out_string) != bgcode::core::EResult::Success)
-                    throw Slic3r::RuntimeError("Error while sending gcode to the binarizer.");
-            }
-            else
-            {
-                write_to_file(out, out_string, result, out_path);
-                update_lines_ends_and_out_file_pos(out_string, result.lines_ends.front(), &m_out_file_pos);
-            }
+            export_string(out, out_string, result, out_path);
         }
 
         // flush the current content of the cache to file
@@ -5889,22 +5725,13 @@ void GCodeProcessor::post_process()
             m_statistics.remove_all_lines();
 #endif // NDEBUG
 
-            if (m_binarizer.is_enabled())
-            {
-                if (m_binarizer.append_gcode(out_string) != bgcode::core::EResult::Success)
-                    throw Slic3r::RuntimeError("Error while sending gcode to the binarizer.");
-            }
-            else
-            {
-                write_to_file(out, out_string, result, out_path);
-                update_lines_ends_and_out_file_pos(out_string, result.lines_ends.front(), &m_out_file_pos);
-            }
+            export_string(out, out_string, result, out_path);
         }
 
         void synchronize_moves(GCodeProcessorResult &result) const
         {
             auto it = m_gcode_lines_map.begin();
-            for (GCodeProcessorResult::MoveVertex &move : result.moves)
+            for (GCodeProcessorResult::MoveVertices::Ref move : result.moves)
             {
                 while (it != m_gcode_lines_map.end() && it->first < move.gcode_id)
                 {
@@ -5918,6 +5745,26 @@ void GCodeProcessor::post_process()
         size_t get_size() const { return m_size; }
 
     private:
+        void export_string(FilePtr &out, const std::string &out_string, GCodeProcessorResult &result,
+                           const std::string &out_path)
+        {
+            if (m_out_vf != nullptr)
+            {
+                m_out_vf->append(out_string);
+                update_lines_ends_and_out_file_pos(out_string, result.lines_ends.front(), &m_out_file_pos);
+            }
+            else if (m_binarizer.is_enabled())
+            {
+                if (m_binarizer.append_gcode(out_string) != bgcode::core::EResult::Success)
+                    throw Slic3r::RuntimeError("Error while sending gcode to the binarizer.");
+            }
+            else
+            {
+                write_to_file(out, out_string, result, out_path);
+                update_lines_ends_and_out_file_pos(out_string, result.lines_ends.front(), &m_out_file_pos);
+            }
+        }
+
         void write_to_file(FilePtr &out, const std::string &out_string, GCodeProcessorResult &result,
                            const std::string &out_path)
         {
@@ -5937,7 +5784,7 @@ void GCodeProcessor::post_process()
         }
     };
 
-    ExportLines export_lines(m_binarizer,
+    ExportLines export_lines(m_binarizer, out_vf.get(),
                              m_result.backtrace_enabled ? ExportLines::EWriteType::ByTime
                                                         : ExportLines::EWriteType::BySize,
                              m_time_processor.machines);
@@ -6244,11 +6091,84 @@ void GCodeProcessor::post_process()
     // to flush the backtrace cache accordingly
     float max_backtrace_time = 120.0f;
 
+    // Extract the lines of the data and process them. The end of the data is the end of a line if eof is set,
+    // otherwise the unterminated line is kept in gcode_line to be completed by the following data.
+    auto process_data = [&](const char *it, const char *it_bufend, bool eof)
+    {
+        while (it != it_bufend || (eof && !gcode_line.empty()))
+        {
+            // Find end of line.
+            const char *it_end = GCodeReader::find_eol(it, it_bufend);
+            // End of line is indicated also if end of file was reached.
+            bool eol = it_end != it_bufend || eof;
+            gcode_line.insert(gcode_line.end(), it, it_end);
+            if (eol)
+            {
+                ++line_id;
+                gcode_line += "\n";
+                const unsigned int internal_g1_lines_counter = export_lines.update(gcode_line, line_id,
+                                                                                   g1_lines_counter);
+                // replace placeholder lines
+                bool processed = process_placeholders(gcode_line);
+                if (processed)
+                    gcode_line.clear();
+                if (!processed)
+                    processed = process_used_filament(gcode_line);
+                if (!processed && !is_temporary_decoration(gcode_line))
+                {
+                    if (GCodeReader::GCodeLine::cmd_is(gcode_line, "G0") ||
+                        GCodeReader::GCodeLine::cmd_is(gcode_line, "G1"))
+                    {
+                        export_lines.append_line(gcode_line);
+                        // add lines M73 where needed
+                        process_line_G1(g1_lines_counter++);
+                        gcode_line.clear();
+                    }
+                    else if (GCodeReader::GCodeLine::cmd_is(gcode_line, "G2") ||
+                             GCodeReader::GCodeLine::cmd_is(gcode_line, "G3"))
+                    {
+                        export_lines.append_line(gcode_line);
+                        // add lines M73 where needed
+                        process_line_G1(g1_lines_counter + internal_g1_lines_counter);
+                        g1_lines_counter += (1 + internal_g1_lines_counter);
+                        gcode_line.clear();
+                    }
+                    else if (GCodeReader::GCodeLine::cmd_is(gcode_line, "G28"))
+                    {
+                        ++g1_lines_counter;
+                    }
+                    else if (m_result.backtrace_enabled && GCodeReader::GCodeLine::cmd_starts_with(gcode_line, "T"))
+                    {
+                        // add lines M104 where needed
+                        process_line_T(gcode_line, g1_lines_counter, backtrace_T);
+                        max_backtrace_time = std::max(max_backtrace_time, backtrace_T.time);
+                    }
+                }
+
+                if (!gcode_line.empty())
+                    export_lines.append_line(gcode_line);
+                export_lines.write(out, 1.1f * max_backtrace_time, m_result, out_path);
+                gcode_line.clear();
+            }
+            // Skip EOL.
+            it = it_end;
+            if (it != it_bufend && *it == '\r')
+                ++it;
+            if (it != it_bufend && *it == '\n')
+                ++it;
+        }
+    };
+
+    assert(gcode_line.empty());
+    if (in_vf != nullptr)
+    {
+        const std::string &buffer = in_vf->get_buffer();
+        process_data(buffer.data(), buffer.data() + buffer.size(), true);
+    }
+    else
     {
         // Read the input stream 64kB at a time, extract lines and process them.
         std::vector<char> buffer(65536 * 10, 0);
-        // Line buffer.
-        assert(gcode_line.empty());
         for (;;)
         {
             size_t cnt_read = ::fread(buffer.data(), 1, buffer.size(), in.f);
@@ -6256,73 +6176,7 @@ void GCodeProcessor::post_process()
                 throw Slic3r::RuntimeError(
                     std::string("GCode processor post process export failed.\nError while reading from file.\n"));
             bool eof = cnt_read == 0;
-            auto it = buffer.begin();
-            auto it_bufend = buffer.begin() + cnt_read;
-            while (it != it_bufend || (eof && !gcode_line.empty()))
-            {
-                // Find end of line.
-                bool eol = false;
-                auto it_end = it;
-                for (; it_end != it_bufend && !(eol = *it_end == '\r' || *it_end == '\n'); ++it_end)
-                    ;
-                // End of line is indicated also if end of file was reached.
-                eol |= eof && it_end == it_bufend;
-                gcode_line.insert(gcode_line.end(), it, it_end);
-                if (eol)
-                {
-                    ++line_id;
-                    gcode_line += "\n";
-                    const unsigned int internal_g1_lines_counter = export_lines.update(gcode_line, line_id,
-                                                                                       g1_lines_counter);
-                    // replace placeholder lines
-                    bool processed = process_placeholders(gcode_line);
-                    if (processed)
-                        gcode_line.clear();
-                    if (!processed)
-                        processed = process_used_filament(gcode_line);
-                    if (!processed && !is_temporary_decoration(gcode_line))
-                    {
-                        if (GCodeReader::GCodeLine::cmd_is(gcode_line, "G0") ||
-                            GCodeReader::GCodeLine::cmd_is(gcode_line, "G1"))
-                        {
-                            export_lines.append_line(gcode_line);
-                            // add lines M73 where needed
-                            process_line_G1(g1_lines_counter++);
-                            gcode_line.clear();
-                        }
-                        else if (GCodeReader::GCodeLine::cmd_is(gcode_line, "G2") ||
-                                 GCodeReader::GCodeLine::cmd_is(gcode_line, "G3"))
-                        {
-                            export_lines.append_line(gcode_line);
-                            // add lines M73 where needed
-                            process_line_G1(g1_lines_counter + internal_g1_lines_counter);
-                            g1_lines_counter += (1 + internal_g1_lines_counter);
-                            gcode_line.clear();
-                        }
-                        else if (GCodeReader::GCodeLine::cmd_is(gcode_line, "G28"))
-                        {
-                            ++g1_lines_counter;
-                        }
-                        else if (m_result.backtrace_enabled && GCodeReader::GCodeLine::cmd_starts_with(gcode_line, "T"))
-                        {
-                            // add lines M104 where needed
-                            process_line_T(gcode_line, g1_lines_counter, backtrace_T);
-                            max_backtrace_time = std::max(max_backtrace_time, backtrace_T.time);
-                        }
-                    }
-
-                    if (!gcode_line.empty())
-                        export_lines.append_line(gcode_line);
-                    export_lines.write(out, 1.1f * max_backtrace_time, m_result, out_path);
-                    gcode_line.clear();
-                }
-                // Skip EOL.
-                it = it_end;
-                if (it != it_bufend && *it == '\r')
-                    ++it;
-                if (it != it_bufend && *it == '\n')
-                    ++it;
-            }
+            process_data(buffer.data(), buffer.data() + cnt_read, eof);
             if (eof)
                 break;
         }
@@ -6330,7 +6184,17 @@ void GCodeProcessor::post_process()
 
     export_lines.flush(out, m_result, out_path);
 
-    if (m_binarizer.is_enabled())
+    if (out_vf != nullptr)
+    {
+        export_lines.synchronize_moves(m_result);
+        // The exported G-code replaces the input one, which is not needed anymore.
+        in_vf->clear();
+        m_result.output_virtual_file = out_vf.release();
+        m_result.owns_output_virtual_file = true;
+        return;
+    }
+
+    if (binarize)
     {
         if (m_binarizer.finalize() != bgcode::core::EResult::Success)
             throw Slic3r::RuntimeError("Error while finalizing the gcode binarizer.");
@@ -6340,7 +6204,7 @@ void GCodeProcessor::post_process()
     in.close();
 
     const std::string result_filename = m_result.filename;
-    if (m_binarizer.is_enabled())
+    if (binarize)
     {
         // The list of lines in the binary gcode is different from the original one.
         // This requires to re-process the binarized file to be able to synchronize with it all the data needed by the preview,
@@ -6616,31 +6480,6 @@ void GCodeProcessor::process_filaments(CustomGCode::Type code)
 
 void GCodeProcessor::calculate_time(GCodeProcessorResult &result, size_t keep_last_n_blocks, float additional_time)
 {
-    static size_t s_total_lines = 0;
-    static size_t s_last_move_count = 0;
-    static int s_last_progress = 50;
-    static int s_call_num = 0;
-
-    s_call_num++;
-
-    const size_t current_moves = result.moves.size();
-
-    // Reset on new job (detect when moves decrease, indicating new file)
-    if (current_moves < s_last_move_count)
-    {
-        s_total_lines = 0;
-        s_last_progress = 50;
-        s_call_num = 1;
-    }
-
-    // Get total lines from virtual file on first call
-    if (s_total_lines == 0 && result.virtual_gcode_file)
-    {
-        s_total_lines = result.virtual_gcode_file->line_count();
-    }
-
-    s_last_move_count = current_moves;
-
     // calculate times
     std::vector<TimeMachine::ActualSpeedMove> actual_speed_moves;
     const size_t time_mode_count = static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Count);
@@ -6699,7 +6538,7 @@ void GCodeProcessor::calculate_time(GCodeProcessorResult &result, size_t keep_la
             // synchronize seams actual speed
             if (base_id_old + 1 < result.moves.size())
             {
-                GCodeProcessorResult::MoveVertex &move = result.moves[base_id_old + 1];
+                GCodeProcessorResult::MoveVertices::Ref move = result.moves[base_id_old + 1];
                 if (move.type == EMoveType::Seam)
                     move.actual_feedrate = it->actual_feedrate;
             }
@@ -6708,7 +6547,7 @@ void GCodeProcessor::calculate_time(GCodeProcessorResult &result, size_t keep_la
     }
 
     // Now actually do the insertion of the ranges into the destination vector.
-    std::vector<GCodeProcessorResult::MoveVertex> &m = result.moves;
+    GCodeProcessorResult::MoveVertices &m = result.moves;
     size_t offset = inserted_count;
     const size_t original_size = m.size();
     m.resize(m.size() + offset);    // grow the vector to its final size
@@ -6722,10 +6561,11 @@ void GCodeProcessor::calculate_time(GCodeProcessorResult &result, size_t keep_la
 
         for (int i = last_pos; i >= new_pos + new_moves.size(); --i)
         { // Move the elements to their final place.
-            m[i] = m[i - offset];
+            m.copy(i, i - offset);
         }
 
-        std::copy(new_moves.begin(), new_moves.end(), m.begin() + new_pos);
+        for (size_t i = 0; i < new_moves.size(); ++i)
+            m.set(new_pos + i, new_moves[i]);
         last_pos = new_pos - 1;
         offset -= new_moves.size();
     }
@@ -6750,11 +6590,10 @@ void GCodeProcessor::calculate_time(GCodeProcessorResult &result, size_t keep_la
         progress = std::min(progress, 85); // Cap at 85%
 
         // Only update if progress increased (avoid UI flicker)
-        // Note: Uses s_last_progress from top of function (line 5027), which resets between jobs
-        if (progress > s_last_progress)
+        if (progress > m_last_progress)
         {
             m_print->set_status(progress, _u8L("Processing G-code"));
-            s_last_progress = progress;
+            m_last_progress = progress;
         }
     }
 }
@@ -6981,7 +6820,7 @@ double GCodeProcessor::extract_absolute_position_on_axis(Axis axis, const GCodeR
 
         void synchronize_moves(GCodeProcessorResult& result) const {
             auto it = m_gcode_lines_map.begin();
-            for (GCodeProcessorResult::MoveVertex& move : result.moves) {
+            for (GCodeProcessorResult::MoveVertices::Ref move : result.moves) {
                 while (it != m_gcode_lines_map.end() && it->first < move.gcode_id) {
                     ++it;
                 }
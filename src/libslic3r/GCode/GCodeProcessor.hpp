@@ -18,6 +18,10 @@
 
 #include <cstdint>
 #include <array>
+#include <atomic>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -148,10 +152,191 @@ struct GCodeProcessorResult
         float actual_volumetric_rate() const { return actual_feedrate * mm3_per_mm; }
     };
 
+    // Moves stored column by column (structure of arrays) without the padding of MoveVertex.
+    // The passes over all the moves (time statistics, build volume test, preview loading) read just a few
+    // fields of each move. Indexing and iterating yield Ref / ConstRef proxies referencing the fields
+    // of a single move under the names of MoveVertex, convertible to a MoveVertex copy.
+    class MoveVertices
+    {
+        using Times = decltype(MoveVertex::time);
+        using Columns = std::tuple<std::vector<unsigned int>, std::vector<EMoveType>, std::vector<GCodeExtrusionRole>,
+                                   std::vector<unsigned char>, std::vector<unsigned char>, std::vector<Vec3f>,
+                                   std::vector<float>, std::vector<float>, std::vector<float>, std::vector<float>,
+                                   std::vector<float>, std::vector<float>, std::vector<float>, std::vector<float>,
+                                   std::vector<Times>, std::vector<unsigned int>, std::vector<unsigned char>>;
+
+        // Fields of a MoveVertex in the order of the columns.
+        template<typename Move>
+        static auto fields(Move &m)
+        {
+            return std::tie(m.gcode_id, m.type, m.extrusion_role, m.extruder_id, m.cp_color_id, m.position,
+                            m.delta_extruder, m.feedrate, m.actual_feedrate, m.width, m.height, m.mm3_per_mm,
+                            m.fan_speed, m.temperature, m.time, m.layer_id, m.internal_only);
+        }
+
+        template<bool IsConst>
+        struct RefT
+        {
+            template<typename T>
+            using Field = std::conditional_t<IsConst, const T, T> &;
+
+            Field<unsigned int> gcode_id;
+            Field<EMoveType> type;
+            Field<GCodeExtrusionRole> extrusion_role;
+            Field<unsigned char> extruder_id;
+            Field<unsigned char> cp_color_id;
+            Field<Vec3f> position;
+            Field<float> delta_extruder;
+            Field<float> feedrate;
+            Field<float> actual_feedrate;
+            Field<float> width;
+            Field<float> height;
+            Field<float> mm3_per_mm;
+            Field<float> fan_speed;
+            Field<float> temperature;
+            Field<Times> time;
+            Field<unsigned int> layer_id;
+            // Stored as a byte, std::vector<bool> does not hand out references.
+            Field<unsigned char> internal_only;
+
+            float volumetric_rate() const { return feedrate * mm3_per_mm; }
+            float actual_volumetric_rate() const { return actual_feedrate * mm3_per_mm; }
+
+            operator MoveVertex() const
+            {
+                MoveVertex out;
+                fields(out) = fields(*this);
+                return out;
+            }
+        };
+
+        template<bool IsConst>
+        class IteratorT
+        {
+        public:
+            using Container = std::conditional_t<IsConst, const MoveVertices, MoveVertices>;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = MoveVertex;
+            using difference_type = std::ptrdiff_t;
+            using reference = RefT<IsConst>;
+            using pointer = void;
+
+            IteratorT(Container &container, size_t idx) : m_container(&container), m_idx(idx) {}
+            reference operator*() const { return (*m_container)[m_idx]; }
+            IteratorT &operator++()
+            {
+                ++m_idx;
+                return *this;
+            }
+            IteratorT operator++(int)
+            {
+                IteratorT out = *this;
+                ++m_idx;
+                return out;
+            }
+            bool operator==(const IteratorT &rhs) const { return m_idx == rhs.m_idx; }
+            bool operator!=(const IteratorT &rhs) const { return m_idx != rhs.m_idx; }
+
+        private:
+            Container *m_container;
+            size_t m_idx;
+        };
+
+        template<typename Fn>
+        void for_each_column(Fn &&fn)
+        {
+            std::apply([&fn](auto &...column) { (fn(column), ...); }, m_columns);
+        }
+
+        Columns m_columns;
+
+    public:
+        using Ref = RefT<false>;
+        using ConstRef = RefT<true>;
+        using iterator = IteratorT<false>;
+        using const_iterator = IteratorT<true>;
+
+        size_t size() const { return std::get<0>(m_columns).size(); }
+        bool empty() const { return std::get<0>(m_columns).empty(); }
+        void clear()
+        {
+            for_each_column([](auto &column) { column.clear(); });
+        }
+        void shrink_to_fit()
+        {
+            for_each_column([](auto &column) { column.shrink_to_fit(); });
+        }
+        void reserve(size_t n)
+        {
+            for_each_column([n](auto &column) { column.reserve(n); });
+        }
+        // New moves are default constructed.
+        void resize(size_t n)
+        {
+            const MoveVertex def;
+            std::apply([n, &def](auto &...column)
+                       { std::apply([n, &column...](const auto &...value) { (column.resize(n, value), ...); },
+                                    fields(def)); },
+                       m_columns);
+        }
+
+        Ref operator[](size_t i)
+        {
+            return std::apply([i](auto &...column) { return Ref{column[i]...}; }, m_columns);
+        }
+        ConstRef operator[](size_t i) const
+        {
+            return std::apply([i](const auto &...column) { return ConstRef{column[i]...}; }, m_columns);
+        }
+        Ref back() { return (*this)[this->size() - 1]; }
+        ConstRef back() const { return (*this)[this->size() - 1]; }
+
+        iterator begin() { return {*this, 0}; }
+        iterator end() { return {*this, this->size()}; }
+        const_iterator begin() const { return {*this, 0}; }
+        const_iterator end() const { return {*this, this->size()}; }
+
+        void push_back(const MoveVertex &move)
+        {
+            std::apply([&move](auto &...column)
+                       { std::apply([&column...](const auto &...value) { (column.push_back(value), ...); },
+                                    fields(move)); },
+                       m_columns);
+        }
+        Ref emplace_back(const MoveVertex &move)
+        {
+            this->push_back(move);
+            return this->back();
+        }
+        void set(size_t i, const MoveVertex &move)
+        {
+            Ref ref = (*this)[i];
+            fields(ref) = fields(move);
+        }
+        // Copy move src over move dst.
+        void copy(size_t dst, size_t src)
+        {
+            for_each_column([dst, src](auto &column) { column[dst] = column[src]; });
+        }
+        void erase(size_t i)
+        {
+            for_each_column([i](auto &column) { column.erase(column.begin() + i); });
+        }
+
+        // Columns for the passes reading a single field of all moves.
+        const std::vector<EMoveType> &types() const { return std::get<1>(m_columns); }
+        const std::vector<GCodeExtrusionRole> &extrusion_roles() const { return std::get<2>(m_columns); }
+        const std::vector<Vec3f> &positions() const { return std::get<5>(m_columns); }
+        const std::vector<float> &widths() const { return std::get<9>(m_columns); }
+        const std::vector<float> &heights() const { return std::get<10>(m_columns); }
+        const std::vector<Times> &times() const { return std::get<14>(m_columns); }
+        const std::vector<unsigned int> &layer_ids() const { return std::get<15>(m_columns); }
+    };
+
     std::string filename;
     bool is_binary_file;
     unsigned int id;
-    std::vector<MoveVertex> moves;
+    MoveVertices moves;
     // Positions of ends of lines of the final G-code this->filename after TimeProcessor::post_process() finalizes the G-code.
     // Binarized gcodes usually have several gcode blocks. Each block has its own list on ends of lines.
     // Ascii gcodes have only one list on ends of lines
@@ -537,10 +722,10 @@ public:
 
             const Vec3f position = m_result.moves.back().position;
 
-            GCodeProcessorResult::MoveVertex &move = m_result.moves.emplace_back(m_result.moves[*m_move_id]);
+            GCodeProcessorResult::MoveVertices::Ref move = m_result.moves.emplace_back(m_result.moves[*m_move_id]);
             move.position = position;
             move.height = height;
-            m_result.moves.erase(m_result.moves.begin() + *m_move_id);
+            m_result.moves.erase(*m_move_id);
             m_result.custom_gcode_per_print_z[*m_custom_gcode_per_print_z_id].print_z = position.z();
             reset();
         }
@@ -643,9 +828,12 @@ private:
     UsedFilaments m_used_filaments;
 
     Print *m_print{nullptr};
+    // Last progress reported by calculate_time() while processing the G-code of the current print.
+    int m_last_progress{50};
 
     GCodeProcessorResult m_result;
-    static unsigned int s_result_id;
+    // Shared by the processors of the prints processed at the same time.
+    static std::atomic<unsigned int> s_result_id;
 
     VirtualGCodeFile *m_virtual_file = nullptr;
     bool m_use_virtual_file = false;
@@ -851,12 +1039,14 @@ private:
     void process_T(const GCodeReader::GCodeLine &line);
     void process_T(const std::string_view command);
 
-    // post process the file with the given filename to:
+    // post process the file with the given filename, or the virtual file, to:
     // 1) add remaining time lines M73 and update moves' gcode ids accordingly
     // 2) update used filament data
     void post_process();
 
-    void post_process_virtual_file();
+    // Process the G-code lines of the virtual file, which were not passed to process_buffer() while exporting,
+    // and finalize the times of the moves.
+    void process_virtual_file();
 
     void store_move_vertex(EMoveType type, bool internal_only = false);
 
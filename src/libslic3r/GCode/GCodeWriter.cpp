@@ -19,9 +19,12 @@
 #include <string_view>
 #include <cassert>
 #include <cinttypes>
+#include <cstdlib>
 
 #include "libslic3r/libslic3r.h"
 
+#include <fast_float.h>
+
 #ifdef __APPLE__
 #include <boost/spirit/include/karma.hpp>
 #endif
@@ -328,7 +331,7 @@ std::string GCodeWriter::set_speed(double F, const std::string_view comment,
     w.emit_f(F);
     w.emit_comment(this->config.gcode_comments, comment);
     w.emit_string(cooling_marker);
-    return w.string();
+    return this->emit_move(w);
 }
 
 std::string GCodeWriter::travel_to_xy_force(const Vec2d &point, const std::string_view comment)
@@ -338,7 +341,7 @@ std::string GCodeWriter::travel_to_xy_force(const Vec2d &point, const std::strin
     w.emit_f(this->get_travel_speed() * 60.0);
     w.emit_comment(this->config.gcode_comments, comment);
     m_pos.head<2>() = point.head<2>();
-    return w.string();
+    return this->emit_move(w);
 }
 
 std::string GCodeWriter::travel_to_xy(const Vec2d &point, const std::string_view comment)
@@ -369,7 +372,7 @@ std::string GCodeWriter::travel_to_xy_G2G3IJ(const Vec2d &point, const Vec2d &ij
     w.emit_xy(point);
     w.emit_ij(ij);
     w.emit_comment(this->config.gcode_comments, comment);
-    return w.string();
+    return this->emit_move(w);
 }
 
 std::string GCodeWriter::travel_to_xyz(const Vec3d &to, const std::string_view comment)
@@ -420,7 +423,7 @@ std::string GCodeWriter::travel_to_xyz_force(const Vec3d &to, const std::string_
 
     w.emit_comment(this->config.gcode_comments, comment);
     m_pos = to;
-    return w.string();
+    return this->emit_move(w);
 }
 
 std::string GCodeWriter::travel_to_z(double z, const std::string_view comment)
@@ -446,7 +449,7 @@ std::string GCodeWriter::travel_to_z_force(double z, const std::string_view comm
     w.emit_f(speed * 60.0);
     w.emit_comment(this->config.gcode_comments, comment);
     m_pos.z() = z;
-    return w.string();
+    return this->emit_move(w);
 }
 
 std::string GCodeWriter::extrude_to_xy(const Vec2d &point, double dE, const std::string_view comment)
@@ -460,7 +463,7 @@ std::string GCodeWriter::extrude_to_xy(const Vec2d &point, double dE, const std:
     w.emit_xy(point);
     w.emit_e(m_extrusion_axis, m_extruder->extrude(dE).second);
     w.emit_comment(this->config.gcode_comments, comment);
-    return w.string();
+    return this->emit_move(w);
 }
 
 std::string GCodeWriter::extrude_to_xyz(const Vec3d &point, double dE, const std::string_view comment)
@@ -471,7 +474,7 @@ std::string GCodeWriter::extrude_to_xyz(const Vec3d &point, double dE, const std
     w.emit_xyz(point);
     w.emit_e(m_extrusion_axis, m_extruder->extrude(dE).second);
     w.emit_comment(this->config.gcode_comments, comment);
-    return w.string();
+    return this->emit_move(w);
 }
 
 std::string GCodeWriter::extrude_to_xy_G2G3IJ(const Vec2d &point, const Vec2d &ij, const bool ccw, double dE,
@@ -492,7 +495,7 @@ std::string GCodeWriter::extrude_to_xy_G2G3IJ(const Vec2d &point, const Vec2d &i
     w.emit_ij(ij);
     w.emit_e(m_extrusion_axis, m_extruder->extrude(dE).second);
     w.emit_comment(this->config.gcode_comments, comment);
-    return w.string();
+    return this->emit_move(w);
 }
 
 #if 0
@@ -506,10 +509,18 @@ std::string GCodeWriter::extrude_to_xyz(const Vec3d &point, double dE, const std
     w.emit_xyz(point);
     w.emit_e(m_extrusion_axis, m_extruder->E());
     w.emit_comment(this->config.gcode_comments, comment);
-    return w.string();
+    return this->emit_move(w);
 }
 #endif
 
+std::string GCodeWriter::emit_move(GCodeFormatter &w) const
+{
+    std::string out = w.string();
+    if (m_moves)
+        m_moves->append(out, w.move());
+    return out;
+}
+
 std::string GCodeWriter::retract(bool before_wipe)
 {
     double factor = before_wipe ? m_extruder->retract_before_wipe() : 1.;
@@ -558,7 +569,7 @@ std::string GCodeWriter::_retract(double length, double restart_extra, const std
             w.emit_e(m_extrusion_axis, emitE);
             w.emit_f(m_extruder->retract_speed() * 60.);
             w.emit_comment(this->config.gcode_comments, comment);
-            gcode = w.string();
+            gcode = this->emit_move(w);
         }
     }
 
@@ -589,7 +600,7 @@ std::string GCodeWriter::unretract()
             w.emit_e(m_extrusion_axis, emitE);
             w.emit_f(m_extruder->deretract_speed() * 60.);
             w.emit_comment(this->config.gcode_comments, " ; unretract");
-            gcode += w.string();
+            gcode += this->emit_move(w);
         }
     }
 
@@ -703,6 +714,21 @@ void GCodeFormatter::emit_axis(const char axis, const double v, size_t digits)
         *(++this->ptr_err.ptr) = '0';
     this->ptr_err.ptr++;
 
+    // Record the value as a G-code reader parses it from the text, see GCodeMoves.
+    const GCodeMove::Axis move_axis = (axis >= 'X' && axis <= 'Z') ? GCodeMove::Axis(GCodeMove::X + (axis - 'X'))
+                                      : (axis >= 'I' && axis <= 'K') ? GCodeMove::Axis(GCodeMove::I + (axis - 'I'))
+                                      : axis == 'F'                  ? GCodeMove::F
+                                      : axis == 'R'                  ? GCodeMove::R
+                                                                     : GCodeMove::E;
+    float value;
+    if (std::abs(v_int) <= (int64_t(1) << 24))
+        // Both operands are exact floats, thus the quotient is the float nearest to the decimal number,
+        // which is what parsing the text produces.
+        value = float(v_int) / float(pow_10[digits]);
+    else
+        fast_float::from_chars(base_ptr, this->ptr_err.ptr, value);
+    m_move.set(move_axis, value);
+
 #if 0  // #ifndef NDEBUG
     {
         // Verify that the optimized formatter produces the same result as the standard sprintf().
@@ -25,10 +25,13 @@
 #include "libslic3r/Point.hpp"
 #include "libslic3r/PrintConfig.hpp"
 #include "CoolingBuffer.hpp"
+#include "GCodeMoves.hpp"
 
 namespace Slic3r
 {
 
+class GCodeFormatter;
+
 class GCodeWriter
 {
 public:
@@ -155,6 +158,9 @@ public:
     // Returns whether this flavor supports separate print and travel acceleration.
     static bool supports_separate_travel_acceleration(GCodeFlavor flavor);
 
+    // Record the moves formatted from now on into moves, nullptr to stop recording.
+    void set_moves(GCodeMoves *moves) { m_moves = moves; }
+
     // To be called by the CoolingBuffer from another thread.
     static std::string set_fan(const GCodeFlavor gcode_flavor, bool gcode_comments, unsigned int speed);
     // To be called by the main thread. It always emits the G-code, it does not remember the previous state.
@@ -178,6 +184,8 @@ private:
     unsigned int m_last_bed_temperature;
     bool m_last_bed_temperature_reached;
     Vec3d m_pos = Vec3d::Zero();
+    // Sink of the formatted moves, see set_moves().
+    GCodeMoves *m_moves{nullptr};
     
     // Travel speed override for first layer (mm/s). If > 0, used instead of config.travel_speed.
     double m_travel_speed_override = 0.0;
@@ -198,6 +206,8 @@ private:
 
     std::string _retract(double length, double restart_extra, const std::string_view comment);
     std::string set_acceleration_internal(Acceleration type, unsigned int acceleration);
+    // Finish the line of the formatter and record it into m_moves.
+    std::string emit_move(GCodeFormatter &w) const;
 };
 
 class GCodeFormatter
@@ -322,11 +332,15 @@ public:
         return std::string(this->buf, ptr_err.ptr - buf);
     }
 
+    // Axis values emitted so far, as a G-code reader parses them from the text.
+    const GCodeMove &move() const { return m_move; }
+
 protected:
     static constexpr const size_t buflen = 256;
     char buf[buflen];
     char *buf_end;
     std::to_chars_result ptr_err;
+    GCodeMove m_move;
 };
 
 class GCodeG1Formatter : public GCodeFormatter
@@ -11,11 +11,13 @@
 #include <array>
 #include <iterator>
 #include <limits>
+#include <string_view>
 #include <cctype>
 #include <cstdlib>
 
 #include "libslic3r/PrintConfig.hpp"
 #include "libslic3r/GCode.hpp"
+#include "libslic3r/GCodeReader.hpp"
 #include "GCodeWriter.hpp"
 #include "libslic3r/GCode/PressureEqualizer.hpp"
 #include "libslic3r/Exception.hpp"
@@ -109,13 +111,12 @@ void PressureEqualizer::process_layer(const std::string &gcode)
     if (!gcode.empty())
     {
         const char *gcode_begin = gcode.c_str();
+        const char *gcode_buffer_end = gcode.c_str() + gcode.size();
         while (*gcode_begin != 0)
         {
             // Find end of the line.
-            const char *gcode_end = gcode_begin;
             // Slic3r always generates end of lines in a Unix style.
-            for (; *gcode_end != 0 && *gcode_end != '\n'; ++gcode_end)
-                ;
+            const char *gcode_end = GCodeReader::find_first_of(gcode_begin, gcode_buffer_end, '\n', 0, 0);
 
             m_gcode_lines.emplace_back();
             if (!this->process_line(gcode_begin, gcode_end, m_gcode_lines.back()))
@@ -302,7 +303,9 @@ static inline float parse_float(const char *&line, const size_t line_length)
 bool PressureEqualizer::process_line(const char *line, const char *line_end, GCodeLine &buf)
 {
     const size_t len = line_end - line;
-    const std::string str_line(line, line_end);
+    const std::string_view str_line(line, line_end - line);
+    // All the tags searched for below start with ';', thus only the comment is searched.
+    const std::string_view str_comment = str_line.substr(std::min(str_line.find(';'), str_line.size()));
     if (strncmp(line, EXTRUSION_ROLE_TAG.data(), EXTRUSION_ROLE_TAG.length()) == 0)
     {
         line += EXTRUSION_ROLE_TAG.length();
@@ -338,8 +341,10 @@ bool PressureEqualizer::process_line(const char *line, const char *line_end, GCo
     buf.extrusion_role = m_current_extrusion_role;
     buf.perimeter_index = m_current_perimeter_index;
 
-    const bool found_extrude_set_speed_tag = boost::contains(str_line, EXTRUDE_SET_SPEED_TAG);
-    const bool found_extrude_end_tag = boost::contains(str_line, EXTRUDE_END_TAG);
+    const bool found_extrude_set_speed_tag = !str_comment.empty() &&
+                                             str_comment.find(EXTRUDE_SET_SPEED_TAG) != std::string_view::npos;
+    const bool found_extrude_end_tag = !str_comment.empty() &&
+                                       str_comment.find(EXTRUDE_END_TAG) != std::string_view::npos;
     assert(!found_extrude_set_speed_tag || !found_extrude_end_tag);
 
     if (found_extrude_set_speed_tag)
@@ -413,12 +418,12 @@ bool PressureEqualizer::process_line(const char *line, const char *line_end, GCo
             }
             else if (m_current_extrusion_role == GCodeExtrusionRole::Perimeter)
             {
-                auto internal_perimeter_it_range = boost::find_last(str_line, INTERNAL_PERIMETER_TAG);
-                if (!internal_perimeter_it_range.empty())
+                const size_t internal_perimeter_pos = str_comment.rfind(INTERNAL_PERIMETER_TAG);
+                if (internal_perimeter_pos != std::string_view::npos)
                 {
                     uint16_t perimetr_index = 0;
-                    const char *start_ptr = str_line.data() +
-                                            std::distance(str_line.begin(), internal_perimeter_it_range.end());
+                    const char *start_ptr = str_comment.data() + internal_perimeter_pos +
+                                            INTERNAL_PERIMETER_TAG.size();
                     const char *end_ptr = str_line.data() + str_line.size();
                     const auto res = std::from_chars(start_ptr, end_ptr, perimetr_index);
                     if (res.ec == std::errc())
@@ -6,6 +6,7 @@
 #define slic3r_VirtualGCodeFile_hpp_
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdio>
 #include <algorithm>
@@ -43,9 +44,14 @@ public:
         if (!data)
             return;
 
-        size_t len = strlen(data);
+        append(std::string_view(data, strlen(data)));
+    }
+
+    // Append a block of lines, the length of the data is known.
+    void append(std::string_view data)
+    {
         size_t old_size = m_buffer.size();
-        m_buffer.append(data, len);
+        m_buffer.append(data);
 
         // Track new lines
         for (size_t i = old_size; i < m_buffer.size(); ++i)
@@ -5,18 +5,38 @@
 ///|/
 #include "GCodeReader.hpp"
 
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/log/trivial.hpp>
 #include <boost/nowide/cstdio.hpp>
 #include <fast_float.h>
+#include <oneapi/tbb/task_arena.h>
+#include <oneapi/tbb/task_group.h>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <condition_variable>
+#include <limits>
 #include <cstdio>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
 
+#include "Thread.hpp"
 #include "Utils.hpp"
 #include "libslic3r/PrintConfig.hpp"
 #include "libslic3r/libslic3r.h"
 
+// SSE2 is part of the x86-64 baseline, thus it is used without runtime detection.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SLIC3R_GCODEREADER_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Slic3r
 {
 
@@ -42,6 +62,20 @@ void GCodeReader::apply_config(const DynamicPrintConfig &config)
 
 const char *GCodeReader::parse_line_internal(const char *ptr, const char *end, GCodeLine &gline,
                                              std::pair<const char *, const char *> &command)
+{
+    const char *c = this->tokenize_line(ptr, end, gline, command);
+
+    if (gline.has(E) && m_config.use_relative_e_distances)
+        m_position[E] = 0;
+
+    if (m_verbose)
+        std::cout << gline.m_raw << std::endl;
+
+    return c;
+}
+
+const char *GCodeReader::tokenize_line(const char *ptr, const char *end, GCodeLine &gline,
+                                       std::pair<const char *, const char *> &command) const
 {
     assert(is_decimal_separator_point());
 
@@ -110,12 +144,9 @@ const char *GCodeReader::parse_line_internal(const char *ptr, const char *end, G
         }
     }
 
-    if (gline.has(E) && m_config.use_relative_e_distances)
-        m_position[E] = 0;
-
     // Skip the rest of the line.
-    for (; !is_end_of_line(*c); ++c)
-        ;
+    if (!is_end_of_line(*c))
+        c = find_first_of(c, end, '\r', '\n', 0);
 
     // Copy the raw string including the comment, without the trailing newlines.
     if (c > ptr)
@@ -127,9 +158,6 @@ const char *GCodeReader::parse_line_internal(const char *ptr, const char *end, G
     if (*c == '\n')
         ++c;
 
-    if (m_verbose)
-        std::cout << gline.m_raw << std::endl;
-
     return c;
 }
 
@@ -176,13 +204,10 @@ bool GCodeReader::parse_file_raw_internal(const std::string &filename, ParseLine
         while (it != it_bufend || (eof && !gcode_line.empty()))
         {
             // Find end of line.
-            bool eol = false;
-            auto it_end = it;
-            for (; it_end != it_bufend && !(eol = *it_end == '\r' || *it_end == '\n'); ++it_end)
-                if (*it_end == '\n')
-                    line_end_callback(file_pos + (it_end - buffer.begin()) + 1);
+            auto it_end = buffer.begin() +
+                          (find_eol(buffer.data() + (it - buffer.begin()), buffer.data() + cnt_read) - buffer.data());
             // End of line is indicated also if end of file was reached.
-            eol |= eof && it_end == it_bufend;
+            bool eol = it_end != it_bufend || eof;
             if (eol)
             {
                 if (gcode_line.empty())
@@ -253,6 +278,174 @@ bool GCodeReader::parse_file_raw(const std::string &filename, raw_line_callback_
         [](size_t) {});
 }
 
+bool GCodeReader::parse_file_parallel(const std::string &filename, callback_t callback,
+                                      std::vector<std::vector<size_t>> &lines_ends)
+{
+    boost::system::error_code ec;
+    const boost::uintmax_t file_size = boost::filesystem::file_size(filename, ec);
+    if (ec)
+        return false;
+    lines_ends.clear();
+    lines_ends.push_back(std::vector<size_t>());
+    if (file_size == 0)
+        return true;
+
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+        file.open(boost::filesystem::path(filename));
+    }
+    catch (const std::exception &ex)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Failed to memory map " << filename << ": " << ex.what()
+                                   << ", falling back to sequential reading.";
+    }
+    if (!file.is_open())
+        return this->parse_file(filename, callback, lines_ends);
+
+    const char *const data_begin = file.data();
+    const char *const data_end = data_begin + file.size();
+
+    // The tokenizer relies on each line being terminated by an end of line character. If the last line is not
+    // terminated, it is copied and parsed separately.
+    const char *lines_end = data_end;
+    while (lines_end != data_begin && *(lines_end - 1) != '\r' && *(lines_end - 1) != '\n')
+        --lines_end;
+    const std::string last_line(lines_end, data_end);
+
+    // Split the file into chunks at line boundaries. A position following '\n' always starts a new line.
+    static constexpr size_t chunk_size = 512 * 1024;
+    struct Chunk
+    {
+        const char *begin;
+        const char *end;
+        std::vector<GCodeLine> lines;
+        std::vector<std::pair<const char *, const char *>> commands;
+        std::vector<size_t> lines_ends;
+        // 0 - waiting, 1 - being tokenized, 2 - tokenized.
+        std::atomic<int> state{0};
+    };
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    for (const char *begin = data_begin; begin != lines_end;)
+    {
+        const char *end = begin + std::min(chunk_size, size_t(lines_end - begin));
+        end = find_first_of(end, lines_end, '\n', '\n', '\n');
+        if (end != lines_end)
+            ++end;
+        auto &chunk = chunks.emplace_back(std::make_unique<Chunk>());
+        chunk->begin = begin;
+        chunk->end = end;
+        begin = end;
+    }
+
+    std::mutex tokenized_mutex;
+    std::condition_variable tokenized_condition;
+    std::atomic<bool> canceled{false};
+    // Split the chunk into lines the same way parse_file_raw() does and tokenize them.
+    auto tokenize_chunk = [this, data_begin, &canceled](Chunk &chunk)
+    {
+        for (const char *ptr = chunk.begin; ptr != chunk.end && !canceled;)
+        {
+            const char *line_end = find_eol(ptr, chunk.end);
+            GCodeLine &gline = chunk.lines.emplace_back();
+            this->tokenize_line(ptr, line_end, gline, chunk.commands.emplace_back());
+            ptr = line_end;
+            if (*ptr == '\r')
+                ++ptr;
+            if (ptr != chunk.end && *ptr == '\n')
+                chunk.lines_ends.emplace_back(size_t(++ptr - data_begin));
+        }
+    };
+
+    // Lines are tokenized by TBB workers a few chunks ahead, while the callbacks are called in the order of the
+    // lines on the calling thread, thus the callback may update the UI and the reader state is the same
+    // as if the file was parsed by parse_file().
+    TBBLocalesSetter locales_setter;
+    tbb::task_group tasks;
+    // Stop the workers if the callback throws.
+    Slic3r::ScopeGuard wait_for_tasks(
+        [&tasks, &canceled]()
+        {
+            canceled = true;
+            tasks.wait();
+        });
+    const size_t num_chunks_ahead = 2 * size_t(std::max(1, tbb::this_task_arena::max_concurrency()));
+    size_t num_chunks_started = 0;
+    m_parsing = true;
+    for (size_t chunk_idx = 0; chunk_idx < chunks.size() && m_parsing; ++chunk_idx)
+    {
+        for (; num_chunks_started < chunks.size() && num_chunks_started <= chunk_idx + num_chunks_ahead;
+             ++num_chunks_started)
+            tasks.run(
+                [&chunk = *chunks[num_chunks_started], &tokenize_chunk, &tokenized_mutex, &tokenized_condition]()
+                {
+                    int waiting = 0;
+                    if (!chunk.state.compare_exchange_strong(waiting, 1))
+                        return;
+                    tokenize_chunk(chunk);
+                    {
+                        std::scoped_lock<std::mutex> lock(tokenized_mutex);
+                        chunk.state = 2;
+                    }
+                    tokenized_condition.notify_all();
+                });
+
+        Chunk &chunk = *chunks[chunk_idx];
+        if (int waiting = 0; chunk.state.compare_exchange_strong(waiting, 1))
+        {
+            // The workers did not get to this chunk yet.
+            tokenize_chunk(chunk);
+            chunk.state = 2;
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(tokenized_mutex);
+            tokenized_condition.wait(lock, [&chunk]() { return chunk.state == 2; });
+        }
+
+        for (size_t i = 0; i < chunk.lines.size() && m_parsing; ++i)
+        {
+            GCodeLine &gline = chunk.lines[i];
+            if (gline.has(E) && m_config.use_relative_e_distances)
+                m_position[E] = 0;
+            callback(*this, gline);
+            update_coordinates(gline, chunk.commands[i]);
+        }
+        append(lines_ends.front(), std::move(chunk.lines_ends));
+        // Release the tokenized lines.
+        chunk.lines = {};
+        chunk.commands = {};
+        chunk.lines_ends = {};
+
+        if (m_progress_callback != nullptr)
+            m_progress_callback(float(chunk.end - data_begin) / float(file_size));
+    }
+
+    if (m_parsing && !last_line.empty())
+        this->parse_line(last_line, callback);
+    return true;
+}
+
+const char *GCodeReader::find_first_of(const char *begin, const char *end, char c1, char c2, char c3)
+{
+#ifdef SLIC3R_GCODEREADER_SSE2
+    const __m128i v1 = _mm_set1_epi8(c1);
+    const __m128i v2 = _mm_set1_epi8(c2);
+    const __m128i v3 = _mm_set1_epi8(c3);
+    for (; end - begin >= 16; begin += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        const __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, v1), _mm_cmpeq_epi8(v, v2)),
+                                        _mm_cmpeq_epi8(v, v3));
+        if (const unsigned int mask = unsigned(_mm_movemask_epi8(eq)); mask != 0)
+            return begin + std::countr_zero(mask);
+    }
+#endif
+    for (; begin != end && *begin != c1 && *begin != c2 && *begin != c3; ++begin)
+        ;
+    return begin;
+}
+
 const char *GCodeReader::axis_pos(const char *raw_str, char axis)
 {
     const char *c = raw_str;
@@ -276,15 +469,56 @@ const char *GCodeReader::axis_pos(const char *raw_str, char axis)
     return nullptr;
 }
 
+void GCodeReader::GCodeLine::index_words() const
+{
+    // The same traversal as GCodeReader::axis_pos(), recording the first word of each letter.
+    m_words_mask = 0;
+    const char *raw_str = m_raw.c_str();
+    const char *c = skip_word(skip_whitespaces(raw_str));
+    while (!is_end_of_gcode_line(*c))
+    {
+        c = skip_whitespaces(c);
+        if (is_end_of_gcode_line(*c))
+            break;
+        if (*c >= 'A' && *c <= 'Z')
+        {
+            const uint32_t bit = 1u << (*c - 'A');
+            if ((m_words_mask & bit) == 0)
+            {
+                if (c - raw_str > std::numeric_limits<uint16_t>::max())
+                {
+                    m_words_state = WordsState::TooLong;
+                    return;
+                }
+                m_words_pos[*c - 'A'] = uint16_t(c - raw_str);
+                m_words_mask |= bit;
+            }
+        }
+        c = skip_word(c);
+    }
+    m_words_state = WordsState::Indexed;
+}
+
 bool GCodeReader::GCodeLine::has(char axis) const
 {
-    return GCodeReader::axis_pos(this->raw().c_str(), axis);
+    return this->axis_pos(axis).data() != nullptr;
 }
 
 std::string_view GCodeReader::GCodeLine::axis_pos(char axis) const
 {
     const std::string &s = this->raw();
-    const char *c = GCodeReader::axis_pos(this->raw().c_str(), axis);
+    const char *c = nullptr;
+    if (axis >= 'A' && axis <= 'Z')
+    {
+        if (m_words_state == WordsState::NotIndexed)
+            this->index_words();
+        if (m_words_state == WordsState::Indexed)
+            c = (m_words_mask & (1u << (axis - 'A'))) ? s.data() + m_words_pos[axis - 'A'] : nullptr;
+        else
+            c = GCodeReader::axis_pos(s.c_str(), axis);
+    }
+    else
+        c = GCodeReader::axis_pos(s.c_str(), axis);
     return c ? std::string_view{c, s.size() - (c - s.data())} : std::string_view();
 }
 
@@ -369,6 +603,7 @@ void GCodeReader::GCodeLine::set(const GCodeReader &reader, const Axis axis, con
     }
     m_axis[axis] = new_value;
     m_mask |= 1 << int(axis);
+    m_words_state = WordsState::NotIndexed;
 }
 
 } // namespace Slic3r
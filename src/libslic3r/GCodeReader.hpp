@@ -39,6 +39,7 @@ public:
             m_mask = 0;
             memset(m_axis, 0, sizeof(m_axis));
             m_raw.clear();
+            m_words_state = WordsState::NotIndexed;
         }
 
         const std::string &raw() const { return m_raw; }
@@ -121,9 +122,23 @@ public:
         }
 
     private:
+        // Find the first word of each letter 'A' to 'Z' in a single pass over the line.
+        void index_words() const;
+
         std::string m_raw;
         float m_axis[NUM_AXES];
         uint32_t m_mask;
+        // Positions of the words in m_raw, indexed on the first query by axis_pos(), has(char) or has_value(char).
+        // Lines longer than 64kB are not indexed, they are searched by axis_pos() instead.
+        enum class WordsState : uint8_t
+        {
+            NotIndexed,
+            Indexed,
+            TooLong
+        };
+        mutable WordsState m_words_state{WordsState::NotIndexed};
+        mutable uint32_t m_words_mask{0};
+        mutable uint16_t m_words_pos['Z' - 'A' + 1];
         friend class GCodeReader;
     };
 
@@ -176,9 +191,17 @@ public:
     // Collect positions of line ends in the binary G-code to be used by the G-code viewer when memory mapping and displaying section of G-code
     // as an overlay in the 3D scene.
     bool parse_file(const std::string &file, callback_t callback, std::vector<std::vector<size_t>> &lines_ends);
+    // Same as parse_file() with lines_ends, but the file is memory mapped and its lines are tokenized in parallel,
+    // while the callback is still called sequentially from the calling thread. Returns false if reading the file failed.
+    bool parse_file_parallel(const std::string &file, callback_t callback, std::vector<std::vector<size_t>> &lines_ends);
     // Just read the G-code file line by line, calls callback (const char *begin, const char *end). Returns false if reading the file failed.
     bool parse_file_raw(const std::string &file, raw_line_callback_t callback);
 
+    // Vectorized search for the first of the characters c1, c2, c3 in [begin, end). Returns end if none was found.
+    static const char *find_first_of(const char *begin, const char *end, char c1, char c2, char c3);
+    // Search for the first '\r' or '\n' in [begin, end). Returns end if none was found.
+    static const char *find_eol(const char *begin, const char *end) { return find_first_of(begin, end, '\r', '\n', '\n'); }
+
     // To be called by the callback to stop parsing.
     void quit_parsing() { m_parsing = false; }
 
@@ -210,6 +233,9 @@ private:
 
     const char *parse_line_internal(const char *ptr, const char *end, GCodeLine &gline,
                                     std::pair<const char *, const char *> &command);
+    // Fill in gline from a single line without touching the reader state, thus it may be called in parallel.
+    const char *tokenize_line(const char *ptr, const char *end, GCodeLine &gline,
+                              std::pair<const char *, const char *> &command) const;
     void update_coordinates(GCodeLine &gline, std::pair<const char *, const char *> &command);
 
     static bool is_whitespace(char c) { return c == ' ' || c == '\t'; }
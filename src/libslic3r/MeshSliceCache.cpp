@@ -0,0 +1,429 @@
+///|/ Copyright (c) preFlight 2025+ oozeBot, LLC
+///|/
+///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
+///|/
+#include "MeshSliceCache.hpp"
+
+#include <boost/algorithm/hex.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/fstream.hpp>
+//FIXME replace with <boost/md5.hpp> after it becomes mainstream, see AppConfig.cpp.
+#include <boost/uuid/detail/md5.hpp>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+
+#include "Model.hpp"
+#include "Print.hpp"
+#include "PrintConfig.hpp"
+#include "Utils.hpp"
+#include "libslic3r_version.h"
+
+namespace Slic3r::MeshSliceCache
+{
+
+// Bump whenever the file layout or the content of the key changes.
+static constexpr uint32_t MESH_SLICE_CACHE_FORMAT_VERSION = 1;
+static constexpr char MESH_SLICE_CACHE_MAGIC[4] = {'P', 'F', 'S', 'C'};
+
+static std::string g_mesh_slice_cache_dir;
+
+void set_mesh_slice_cache_dir(const std::string &path)
+{
+    g_mesh_slice_cache_dir = path;
+}
+
+const std::string &mesh_slice_cache_dir()
+{
+    return g_mesh_slice_cache_dir;
+}
+
+namespace
+{
+
+class KeyBuilder
+{
+public:
+    void bytes(const void *data, size_t size) { m_md5.process_bytes(data, size); }
+    template<typename T> void value(const T &v)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        this->bytes(&v, sizeof(T));
+    }
+    void string(const std::string &s)
+    {
+        this->value(uint64_t(s.size()));
+        this->bytes(s.data(), s.size());
+    }
+    template<typename T> void vector(const std::vector<T> &v)
+    {
+        this->value(uint64_t(v.size()));
+        if (!v.empty())
+            this->bytes(v.data(), v.size() * sizeof(T));
+    }
+    template<typename Config> void config(const Config &config)
+    {
+        for (const t_config_option_key &opt_key : config.keys())
+        {
+            this->string(opt_key);
+            this->string(config.opt_serialize(opt_key));
+        }
+    }
+    void transform(const Transform3d &trafo) { this->bytes(trafo.matrix().data(), 16 * sizeof(double)); }
+
+    std::string digest()
+    {
+        boost::uuids::detail::md5::digest_type digest{};
+        m_md5.get_digest(digest);
+        std::string out;
+        boost::algorithm::hex_lower(digest, digest + std::size(digest), std::back_inserter(out));
+        return out;
+    }
+
+private:
+    boost::uuids::detail::md5 m_md5;
+};
+
+boost::filesystem::path cache_file_path(const std::string &key)
+{
+    return boost::filesystem::path(g_mesh_slice_cache_dir) / (key + ".slices");
+}
+
+template<typename T> bool read_value(std::istream &is, T &v)
+{
+    return bool(is.read(reinterpret_cast<char *>(&v), sizeof(T)));
+}
+
+template<typename T> void write_value(std::ostream &os, const T &v)
+{
+    os.write(reinterpret_cast<const char *>(&v), sizeof(T));
+}
+
+bool read_points(std::istream &is, Points &pts)
+{
+    uint64_t n;
+    if (!read_value(is, n))
+        return false;
+    pts.assign(size_t(n), Point());
+    static_assert(sizeof(Point) == 2 * sizeof(coord_t));
+    return n == 0 || bool(is.read(reinterpret_cast<char *>(pts.data()), std::streamsize(n * sizeof(Point))));
+}
+
+void write_points(std::ostream &os, const Points &pts)
+{
+    write_value(os, uint64_t(pts.size()));
+    if (!pts.empty())
+        os.write(reinterpret_cast<const char *>(pts.data()), std::streamsize(pts.size() * sizeof(Point)));
+}
+
+std::string make_key(const PrintObject &print_object, const std::vector<float> &slice_zs, bool with_trafo)
+{
+    KeyBuilder key;
+    key.string(SLIC3R_VERSION);
+    key.value(MESH_SLICE_CACHE_FORMAT_VERSION);
+
+    // Slicing parameters, see slice_volumes_inner().
+    const PrintConfig &print_config = print_object.print()->config();
+    key.value(print_config.resolution.value);
+    key.value(print_config.spiral_vase.value);
+    key.value(uint64_t(print_config.nozzle_diameter.size()));
+    key.config(print_object.config());
+    if (with_trafo)
+        key.transform(print_object.trafo_centered());
+    key.vector(slice_zs);
+
+    // Meshes in the order of their IDs, which is the order they are sliced and assigned to regions in.
+    ModelVolumePtrs volumes = print_object.model_object()->volumes;
+    std::sort(volumes.begin(), volumes.end(), [](const ModelVolume *l, const ModelVolume *r) { return l->id() < r->id(); });
+    for (const ModelVolume *volume : volumes)
+    {
+        key.value(volume->type());
+        key.value(volume->is_mm_painted());
+        key.transform(volume->get_matrix());
+        const indexed_triangle_set &its = volume->mesh().its;
+        key.vector(its.vertices);
+        key.vector(its.indices);
+    }
+
+    // Assignment of volumes to regions, region configs.
+    auto volume_index = [&volumes](const ModelVolume *volume) -> int64_t
+    { return std::find(volumes.begin(), volumes.end(), volume) - volumes.begin(); };
+    const PrintObjectRegions &regions = *print_object.shared_regions();
+    for (const PrintObjectRegions::LayerRangeRegions &layer_range : regions.layer_ranges)
+    {
+        key.value(layer_range.layer_height_range.first);
+        key.value(layer_range.layer_height_range.second);
+        for (const PrintObjectRegions::VolumeRegion &volume_region : layer_range.volume_regions)
+        {
+            key.value(volume_index(volume_region.model_volume));
+            key.value(volume_region.parent);
+            key.value(volume_region.region ? volume_region.region->print_object_region_id() : -1);
+        }
+    }
+    for (const std::unique_ptr<PrintRegion> &region : regions.all_regions)
+        key.config(region->config());
+
+    return key.digest();
+}
+
+// Transformation in the XY plane mapping the points transformed by trafo_src to the points transformed by trafo_dst,
+// if the two transformations differ just by a rotation or a mirroring around the Z axis and by XY translation.
+std::optional<Transform2d> xy_transformation(const Transform3d &trafo_src, const Transform3d &trafo_dst)
+{
+    static constexpr const double eps = EPSILON;
+    const Matrix3d m = trafo_dst.linear() * trafo_src.linear().inverse();
+    const Vec3d t = trafo_dst.translation() - m * trafo_src.translation();
+    const Matrix2d m2 = m.topLeftCorner<2, 2>();
+    if (std::abs(m(2, 2) - 1.) > eps || std::abs(m(0, 2)) > eps || std::abs(m(1, 2)) > eps ||
+        std::abs(m(2, 0)) > eps || std::abs(m(2, 1)) > eps || std::abs(t.z()) > eps ||
+        !(m2.transpose() * m2).isIdentity(eps))
+        return {};
+    Transform2d out = Transform2d::Identity();
+    out.linear() = m2;
+    out.translation() = Vec2d(scale_(t.x()), scale_(t.y()));
+    return out;
+}
+
+SharedSlices::RegionSlices transform_region_slices(const SharedSlices::RegionSlices &src, const Transform2d &trafo)
+{
+    const bool mirrored = trafo.linear().determinant() < 0.;
+    auto transform_polygon = [&trafo, mirrored](const Polygon &src)
+    {
+        Polygon out;
+        out.points.reserve(src.points.size());
+        for (const Point &pt : src.points)
+            out.points.emplace_back(Vec2d(trafo * pt.cast<double>()));
+        // Keep the contours CCW and the holes CW.
+        if (mirrored)
+            out.reverse();
+        return out;
+    };
+    SharedSlices::RegionSlices out(src.size());
+    for (size_t region_id = 0; region_id < src.size(); ++region_id)
+    {
+        out[region_id].resize(src[region_id].size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, src[region_id].size()),
+                          [&src, &out, region_id, &transform_polygon](const tbb::blocked_range<size_t> &range)
+                          {
+                              for (size_t layer_id = range.begin(); layer_id < range.end(); ++layer_id)
+                              {
+                                  const ExPolygons &expolygons_src = src[region_id][layer_id];
+                                  ExPolygons &expolygons = out[region_id][layer_id];
+                                  expolygons.reserve(expolygons_src.size());
+                                  for (const ExPolygon &expoly_src : expolygons_src)
+                                  {
+                                      ExPolygon &expoly = expolygons.emplace_back();
+                                      expoly.contour = transform_polygon(expoly_src.contour);
+                                      expoly.holes.reserve(expoly_src.holes.size());
+                                      for (const Polygon &hole : expoly_src.holes)
+                                          expoly.holes.emplace_back(transform_polygon(hole));
+                                  }
+                              }
+                          });
+    }
+    return out;
+}
+
+} // namespace
+
+std::string key(const PrintObject &print_object, const std::vector<float> &slice_zs)
+{
+    return make_key(print_object, slice_zs, true);
+}
+
+std::string key_without_trafo(const PrintObject &print_object, const std::vector<float> &slice_zs)
+{
+    return make_key(print_object, slice_zs, false);
+}
+
+bool load(const std::string &key, size_t num_regions, size_t num_layers,
+          std::vector<std::vector<ExPolygons>> &region_slices)
+{
+    const boost::filesystem::path path = cache_file_path(key);
+    boost::system::error_code ec;
+    if (!boost::filesystem::exists(path, ec))
+        return false;
+
+    boost::nowide::ifstream is(path.string(), std::ios::in | std::ios::binary);
+    char magic[4];
+    uint32_t version;
+    uint64_t regions, layers;
+    if (!is.read(magic, 4) || std::memcmp(magic, MESH_SLICE_CACHE_MAGIC, 4) != 0 || !read_value(is, version) ||
+        version != MESH_SLICE_CACHE_FORMAT_VERSION || !read_value(is, regions) || !read_value(is, layers) ||
+        regions != num_regions || layers != num_layers)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Mesh slice cache: Ignoring invalid cache entry " << path.string();
+        return false;
+    }
+
+    std::vector<std::vector<ExPolygons>> out(num_regions, std::vector<ExPolygons>(num_layers));
+    for (std::vector<ExPolygons> &by_layer : out)
+        for (ExPolygons &expolygons : by_layer)
+        {
+            uint64_t num_expolygons;
+            if (!read_value(is, num_expolygons))
+                return false;
+            expolygons.assign(size_t(num_expolygons), ExPolygon());
+            for (ExPolygon &expoly : expolygons)
+            {
+                uint64_t num_holes;
+                if (!read_points(is, expoly.contour.points) || !read_value(is, num_holes))
+                    return false;
+                expoly.holes.assign(size_t(num_holes), Polygon());
+                for (Polygon &hole : expoly.holes)
+                    if (!read_points(is, hole.points))
+                        return false;
+            }
+        }
+
+    region_slices = std::move(out);
+    BOOST_LOG_TRIVIAL(info) << "Mesh slice cache: Loaded slices from " << path.string();
+    return true;
+}
+
+void store(const std::string &key, const std::vector<std::vector<ExPolygons>> &region_slices)
+{
+    const boost::filesystem::path path = cache_file_path(key);
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(path.parent_path(), ec);
+    // Write into a temporary file first and move it into place, so that concurrent jobs sharing the cache
+    // directory never see a partially written entry.
+    const boost::filesystem::path path_tmp = path.parent_path() /
+                                             boost::filesystem::unique_path(path.filename().string() + ".%%%%-%%%%.tmp", ec);
+    {
+        boost::nowide::ofstream os(path_tmp.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+        os.write(MESH_SLICE_CACHE_MAGIC, 4);
+        write_value(os, MESH_SLICE_CACHE_FORMAT_VERSION);
+        write_value(os, uint64_t(region_slices.size()));
+        write_value(os, uint64_t(region_slices.empty() ? 0 : region_slices.front().size()));
+        for (const std::vector<ExPolygons> &by_layer : region_slices)
+            for (const ExPolygons &expolygons : by_layer)
+            {
+                write_value(os, uint64_t(expolygons.size()));
+                for (const ExPolygon &expoly : expolygons)
+                {
+                    write_points(os, expoly.contour.points);
+                    write_value(os, uint64_t(expoly.holes.size()));
+                    for (const Polygon &hole : expoly.holes)
+                        write_points(os, hole.points);
+                }
+            }
+        os.close();
+        if (!os)
+        {
+            BOOST_LOG_TRIVIAL(warning) << "Mesh slice cache: Failed writing " << path_tmp.string();
+            boost::filesystem::remove(path_tmp, ec);
+            return;
+        }
+    }
+    if (std::error_code err = rename_file(path_tmp.string(), path.string()); err)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Mesh slice cache: Failed to move " << path_tmp.string() << " to "
+                                   << path.string() << ": " << err.message();
+        boost::filesystem::remove(path_tmp, ec);
+    }
+}
+
+std::vector<std::vector<size_t>> SharedSlices::set_objects(const std::vector<PrintObject *> &objects)
+{
+    // The objects already sliced do not take part in the sharing.
+    std::vector<std::string> keys(objects.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, objects.size()),
+                      [&objects, &keys](const tbb::blocked_range<size_t> &range)
+                      {
+                          for (size_t i = range.begin(); i < range.end(); ++i)
+                              if (!objects[i]->is_step_done(posSlice))
+                                  keys[i] = key_without_trafo(*objects[i], {});
+                      });
+
+    std::map<std::string, std::vector<size_t>> by_key;
+    for (size_t i = 0; i < objects.size(); ++i)
+        if (!keys[i].empty())
+            by_key[keys[i]].emplace_back(i);
+
+    std::vector<std::vector<size_t>> groups;
+    for (std::pair<const std::string, std::vector<size_t>> &kvp : by_key)
+        if (kvp.second.size() > 1)
+            groups.emplace_back(std::move(kvp.second));
+    std::sort(groups.begin(), groups.end(),
+              [](const std::vector<size_t> &l, const std::vector<size_t> &r) { return l.front() < r.front(); });
+
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_object_groups.clear();
+    m_group_remaining.clear();
+    for (const std::vector<size_t> &group : groups)
+    {
+        for (size_t i : group)
+            m_object_groups[objects[i]] = m_group_remaining.size();
+        m_group_remaining.emplace_back(group.size());
+    }
+    return groups;
+}
+
+SharedSlices::RegionSlices SharedSlices::get_or_slice(const PrintObject &print_object,
+                                                      const std::vector<float> &slice_zs,
+                                                      const std::function<RegionSlices()> &slice)
+{
+    size_t group;
+    {
+        std::scoped_lock<std::mutex> lock(m_mutex);
+        auto it_group = m_object_groups.find(&print_object);
+        if (it_group == m_object_groups.end())
+            // No other object slices the same meshes.
+            return slice();
+        group = it_group->second;
+        m_object_groups.erase(it_group);
+    }
+
+    const std::string key = key_without_trafo(print_object, slice_zs);
+    const Transform3d trafo = print_object.trafo_centered();
+    std::shared_ptr<const RegionSlices> src;
+    Transform2d src_trafo;
+    {
+        std::scoped_lock<std::mutex> lock(m_mutex);
+        for (auto [it, it_end] = m_entries.equal_range(key); it != it_end; ++it)
+            if (std::optional<Transform2d> xy = xy_transformation(it->second.trafo, trafo); xy)
+            {
+                src = it->second.slices;
+                src_trafo = *xy;
+                break;
+            }
+    }
+
+    RegionSlices out;
+    if (src)
+    {
+        BOOST_LOG_TRIVIAL(debug) << "Slice sharing: Reusing slices of an object with identical geometry";
+        out = transform_region_slices(*src, src_trafo);
+    }
+    else
+        out = slice();
+
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    if (--m_group_remaining[group] == 0)
+    {
+        // The last object of the group took its slices, release them.
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+            it = it->second.group == group ? m_entries.erase(it) : std::next(it);
+    }
+    else if (!src)
+        m_entries.insert({key, Entry{trafo, std::make_shared<const RegionSlices>(out), group}});
+    return out;
+}
+
+void SharedSlices::clear()
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_object_groups.clear();
+    m_group_remaining.clear();
+}
+
+} // namespace Slic3r::MeshSliceCache
@@ -0,0 +1,92 @@
+///|/ Copyright (c) preFlight 2025+ oozeBot, LLC
+///|/
+///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
+///|/
+#ifndef slic3r_MeshSliceCache_hpp_
+#define slic3r_MeshSliceCache_hpp_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ExPolygon.hpp"
+#include "Point.hpp"
+
+namespace Slic3r
+{
+
+class PrintObject;
+
+// Persistent on-disk cache of the mesh slicing results of PrintObjects.
+// The cache is content addressed: the key is a digest of the meshes and transformations of the sliced ModelVolumes,
+// of the slicing Z coordinates, of the PrintObjectConfig and of the PrintRegionConfigs of the object.
+// Printer and filament level options (start G-code, temperatures ...) are not part of the key, therefore
+// re-slicing a job with only these options changed reuses the mesh slices of the previous run.
+// Only the mesh slicing is cached, the perimeters, infill and supports are generated from the cached slices again.
+// The cache is disabled unless a cache directory is set with set_mesh_slice_cache_dir().
+namespace MeshSliceCache
+{
+
+// Set the directory to store the cached slices into. Empty path disables the cache.
+void set_mesh_slice_cache_dir(const std::string &path);
+// Return the cache directory, empty if the cache is disabled.
+const std::string &mesh_slice_cache_dir();
+inline bool enabled() { return !mesh_slice_cache_dir().empty(); }
+
+// Digest of everything the region slices of print_object sliced at slice_zs depend on.
+std::string key(const PrintObject &print_object, const std::vector<float> &slice_zs);
+// As above, but without the transformation of print_object.
+std::string key_without_trafo(const PrintObject &print_object, const std::vector<float> &slice_zs);
+
+// Load region slices (indexed by region, then by layer) stored under the key.
+// Returns false if the entry does not exist, cannot be read or does not match the expected dimensions.
+bool load(const std::string &key, size_t num_regions, size_t num_layers,
+          std::vector<std::vector<ExPolygons>> &region_slices);
+// Store region slices under the key. Failure to write the cache entry is logged and otherwise ignored.
+void store(const std::string &key, const std::vector<std::vector<ExPolygons>> &region_slices);
+
+// In-memory sharing of region slices between the PrintObjects of a single Print, which slice the same meshes with
+// the same configuration and differ just by a rotation or mirroring around the Z axis and by XY translation,
+// typically copies of a part added as separate ModelObjects. The first PrintObject of such a group slices,
+// the others transform its slices in 2D.
+class SharedSlices
+{
+public:
+    using RegionSlices = std::vector<std::vector<ExPolygons>>;
+
+    // Group the objects to be sliced by their key_without_trafo() with no slicing Z coordinates. Only the objects
+    // of a group with at least two members share slices. Returns these groups as indices into objects, the members
+    // of a group in the order of objects. The caller slices the members of a group one after another, starting
+    // with the first one, so that an object never waits for the slices of another object.
+    std::vector<std::vector<size_t>> set_objects(const std::vector<PrintObject *> &objects);
+    // Return region slices of print_object sliced at slice_zs. If an object with the same key_without_trafo()
+    // and a transformation differing by a rigid XY transformation has been sliced, its slices are transformed,
+    // otherwise slice() is called. Its result is shared only if other objects of the group of print_object are still
+    // to be sliced, and it is released once the last of them took its slices.
+    RegionSlices get_or_slice(const PrintObject &print_object, const std::vector<float> &slice_zs,
+                              const std::function<RegionSlices()> &slice);
+    // Release all the shared slices and groups.
+    void clear();
+
+private:
+    struct Entry
+    {
+        Transform3d trafo;
+        std::shared_ptr<const RegionSlices> slices;
+        size_t group;
+    };
+    std::mutex m_mutex;
+    // Group index of the objects sharing slices.
+    std::map<const PrintObject *, size_t> m_object_groups;
+    // Number of the objects of each group, which did not take their slices yet.
+    std::vector<size_t> m_group_remaining;
+    std::multimap<std::string, Entry> m_entries;
+};
+
+} // namespace MeshSliceCache
+} // namespace Slic3r
+
+#endif // slic3r_MeshSliceCache_hpp_
@@ -1076,118 +1076,134 @@ static inline std::vector<std::vector<ExPolygons>> segmentation_top_and_bottom_l
 
     if (max_top_layers > 0 || max_bottom_layers > 0)
     {
+        auto merge = [](std::vector<Polygons> &&src, std::vector<Polygons> &dst)
+        {
+            auto it_src = find_if(src.begin(), src.end(), [](const Polygons &p) { return !p.empty(); });
+            if (it_src != src.end())
+            {
+                if (dst.empty())
+                {
+                    dst = std::move(src);
+                }
+                else
+                {
+                    assert(src.size() == dst.size());
+                    auto it_dst = dst.begin() + (it_src - src.begin());
+                    for (; it_src != src.end(); ++it_src, ++it_dst)
+                        if (!it_src->empty())
+                        {
+                            if (it_dst->empty())
+                                *it_dst = std::move(*it_src);
+                            else
+                                append(*it_dst, std::move(*it_src));
+                        }
+                }
+            }
+        };
+
         for (const ModelVolume *mv : print_object.model_object()->volumes)
             if (mv->is_model_part())
             {
                 const Transform3d volume_trafo = object_trafo * mv->get_matrix();
-                for (size_t extruder_idx = 0; extruder_idx < num_facets_states; ++extruder_idx)
-                {
-                    const indexed_triangle_set painted = extract_facets_info(*mv).facets_annotation.get_facets_strict(
-                        *mv, TriangleStateType(extruder_idx));
-
-                    if constexpr (MM_SEGMENTATION_DEBUG_TOP_BOTTOM)
-                    {
-                        its_write_obj(painted, debug_out_path("mm-painted-patch-%d.obj", extruder_idx).c_str());
-                    }
-
-                    if (!painted.indices.empty())
+                const ModelVolumeFacetsInfo facets_info = extract_facets_info(*mv);
+
+                // Triangles not stored in the painting data are not painted, thus the painting data may only be
+                // missing the painted states. Skip them without deserializing the painting.
+                std::vector<size_t> extruder_ids{0};
+                for (size_t extruder_idx = 1; extruder_idx < num_facets_states; ++extruder_idx)
+                    if (facets_info.facets_annotation.has_facets(*mv, TriangleStateType(extruder_idx)))
+                        extruder_ids.emplace_back(extruder_idx);
+
+                // Deserialize the painting once, then extract and slice the painted patches of all states in
+                // parallel. The slabs are merged after each volume to keep just a single volume's slabs in memory.
+                TriangleSelector selector(mv->mesh());
+                selector.deserialize(facets_info.facets_annotation.get_data(), false);
+                std::vector<std::vector<Polygons>> top_per_state(extruder_ids.size());
+                std::vector<std::vector<Polygons>> bottom_per_state(extruder_ids.size());
+                tbb::parallel_for(
+                    tbb::blocked_range<size_t>(0, extruder_ids.size(), 1),
+                    [&](const tbb::blocked_range<size_t> &range)
                     {
-                        std::vector<Polygons> top, bottom;
-                        if (!zs.empty() && is_volume_sinking(painted, volume_trafo))
+                        for (size_t state_idx = range.begin(); state_idx < range.end(); ++state_idx)
                         {
-                            std::vector<float> zs_sinking = {0.f};
-                            Slic3r::append(zs_sinking, zs);
-                            slice_mesh_slabs(painted, zs_sinking, volume_trafo, max_top_layers > 0 ? &top : nullptr,
-                                             max_bottom_layers > 0 ? &bottom : nullptr, throw_on_cancel_callback);
+                            throw_on_cancel_callback();
+                            const size_t extruder_idx = extruder_ids[state_idx];
+                            const indexed_triangle_set painted = selector.get_facets_strict(
+                                TriangleStateType(extruder_idx));
 
-                            MeshSlicingParams slicing_params;
-                            slicing_params.trafo = volume_trafo;
-                            Polygons bottom_slice = slice_mesh(painted, zs[0], slicing_params);
-
-                            top.erase(top.begin());
-                            bottom.erase(bottom.begin());
-
-                            bottom[0] = union_(bottom[0], bottom_slice);
-                        }
-                        else
-                            slice_mesh_slabs(painted, zs, volume_trafo, max_top_layers > 0 ? &top : nullptr,
-                                             max_bottom_layers > 0 ? &bottom : nullptr, throw_on_cancel_callback);
-                        auto merge = [](std::vector<Polygons> &&src, std::vector<Polygons> &dst)
-                        {
-                            auto it_src = find_if(src.begin(), src.end(), [](const Polygons &p) { return !p.empty(); });
-                            if (it_src != src.end())
+                            if constexpr (MM_SEGMENTATION_DEBUG_TOP_BOTTOM)
                             {
-                                if (dst.empty())
-                                {
-                                    dst = std::move(src);
-                                }
-                                else
-                                {
-                                    assert(src.size() == dst.size());
-                                    auto it_dst = dst.begin() + (it_src - src.begin());
-                                    for (; it_src != src.end(); ++it_src, ++it_dst)
-                                        if (!it_src->empty())
-                                        {
-                                            if (it_dst->empty())
-                                                *it_dst = std::move(*it_src);
-                                            else
-                                                append(*it_dst, std::move(*it_src));
-                                        }
-                                }
+                                its_write_obj(painted,
+                                              debug_out_path("mm-painted-patch-%d.obj", extruder_idx).c_str());
                             }
-                        };
-                        merge(std::move(top), top_raw[extruder_idx]);
-                        merge(std::move(bottom), bottom_raw[extruder_idx]);
-                    }
-                }
-            }
-    }
 
-    auto filter_out_small_polygons = [&num_facets_states, &num_layers](std::vector<std::vector<Polygons>> &raw_surfaces,
-                                                                       double min_area) -> void
-    {
-        for (size_t extruder_idx = 0; extruder_idx < num_facets_states; ++extruder_idx)
-        {
-            if (raw_surfaces[extruder_idx].empty())
-                continue;
-
-            for (size_t layer_idx = 0; layer_idx < num_layers; ++layer_idx)
-            {
-                if (raw_surfaces[extruder_idx][layer_idx].empty())
-                    continue;
+                            if (painted.indices.empty())
+                                continue;
 
-                remove_small(raw_surfaces[extruder_idx][layer_idx], min_area);
-            }
-        }
-    };
+                            std::vector<Polygons> &top = top_per_state[state_idx];
+                            std::vector<Polygons> &bottom = bottom_per_state[state_idx];
+                            if (!zs.empty() && is_volume_sinking(painted, volume_trafo))
+                            {
+                                std::vector<float> zs_sinking = {0.f};
+                                Slic3r::append(zs_sinking, zs);
+                                slice_mesh_slabs(painted, zs_sinking, volume_trafo,
+                                                 max_top_layers > 0 ? &top : nullptr,
+                                                 max_bottom_layers > 0 ? &bottom : nullptr, throw_on_cancel_callback);
 
-    // Filter out polygons less than 0.1mm^2, because they are unprintable and causing dimples on outer primers (#7104)
-    filter_out_small_polygons(top_raw, Slic3r::sqr(POLYGON_FILTER_MIN_AREA_SCALED));
-    filter_out_small_polygons(bottom_raw, Slic3r::sqr(POLYGON_FILTER_MIN_AREA_SCALED));
+                                MeshSlicingParams slicing_params;
+                                slicing_params.trafo = volume_trafo;
+                                Polygons bottom_slice = slice_mesh(painted, zs[0], slicing_params);
 
-    // Remove top and bottom surfaces that are covered by the previous or next sliced layer.
-    for (size_t extruder_idx = 0; extruder_idx < num_facets_states; ++extruder_idx)
-    {
-        for (size_t layer_idx = 0; layer_idx < num_layers; ++layer_idx)
-        {
-            const bool has_top_surface = !top_raw[extruder_idx].empty() && !top_raw[extruder_idx][layer_idx].empty();
-            const bool has_bottom_surface = !bottom_raw[extruder_idx].empty() &&
-                                            !bottom_raw[extruder_idx][layer_idx].empty();
+                                top.erase(top.begin());
+                                bottom.erase(bottom.begin());
 
-            if (has_top_surface && layer_idx < (num_layers - 1))
-            {
-                top_raw[extruder_idx][layer_idx] = diff(top_raw[extruder_idx][layer_idx],
-                                                        input_expolygons[layer_idx + 1]);
-            }
+                                bottom[0] = union_(bottom[0], bottom_slice);
+                            }
+                            else
+                                slice_mesh_slabs(painted, zs, volume_trafo, max_top_layers > 0 ? &top : nullptr,
+                                                 max_bottom_layers > 0 ? &bottom : nullptr, throw_on_cancel_callback);
+                        }
+                    });
 
-            if (has_bottom_surface && layer_idx > 0)
-            {
-                bottom_raw[extruder_idx][layer_idx] = diff(bottom_raw[extruder_idx][layer_idx],
-                                                           input_expolygons[layer_idx - 1]);
+                for (size_t state_idx = 0; state_idx < extruder_ids.size(); ++state_idx)
+                {
+                    merge(std::move(top_per_state[state_idx]), top_raw[extruder_ids[state_idx]]);
+                    merge(std::move(bottom_per_state[state_idx]), bottom_raw[extruder_ids[state_idx]]);
+                }
             }
-        }
     }
 
+    // Filter out polygons less than 0.1mm^2, because they are unprintable and causing dimples on outer primers (#7104).
+    // Remove top and bottom surfaces that are covered by the previous or next sliced layer.
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_layers),
+                      [&top_raw, &bottom_raw, &input_expolygons, &num_facets_states, &num_layers,
+                       &throw_on_cancel_callback](const tbb::blocked_range<size_t> &range)
+                      {
+                          for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx)
+                          {
+                              throw_on_cancel_callback();
+                              for (size_t extruder_idx = 0; extruder_idx < num_facets_states; ++extruder_idx)
+                              {
+                                  if (!top_raw[extruder_idx].empty() && !top_raw[extruder_idx][layer_idx].empty())
+                                  {
+                                      Polygons &top = top_raw[extruder_idx][layer_idx];
+                                      remove_small(top, Slic3r::sqr(POLYGON_FILTER_MIN_AREA_SCALED));
+                                      if (!top.empty() && layer_idx < (num_layers - 1))
+                                          top = diff(top, input_expolygons[layer_idx + 1]);
+                                  }
+
+                                  if (!bottom_raw[extruder_idx].empty() &&
+                                      !bottom_raw[extruder_idx][layer_idx].empty())
+                                  {
+                                      Polygons &bottom = bottom_raw[extruder_idx][layer_idx];
+                                      remove_small(bottom, Slic3r::sqr(POLYGON_FILTER_MIN_AREA_SCALED));
+                                      if (!bottom.empty() && layer_idx > 0)
+                                          bottom = diff(bottom, input_expolygons[layer_idx - 1]);
+                                  }
+                              }
+                          }
+                      });
+
     if constexpr (MM_SEGMENTATION_DEBUG_TOP_BOTTOM)
     {
         const std::vector<std::string> colors = {"aqua",   "black", "blue",   "fuchsia", "gray",
@@ -1285,6 +1301,11 @@ static inline std::vector<std::vector<ExPolygons>> segmentation_top_and_bottom_l
                 for (size_t color_idx = 0; color_idx < num_facets_states; ++color_idx)
                 {
                     throw_on_cancel_callback();
+                    const bool has_top = !top_raw[color_idx].empty() && !top_raw[color_idx][layer_idx].empty();
+                    const bool has_bottom = !bottom_raw[color_idx].empty() &&
+                                            !bottom_raw[color_idx][layer_idx].empty();
+                    if (!has_top && !has_bottom)
+                        continue;
                     LayerColorStat stat = layer_color_stat(layer_idx, color_idx);
                     if (std::vector<Polygons> &top = top_raw[color_idx]; !top.empty() && !top[layer_idx].empty())
                     {
@@ -2064,7 +2064,7 @@ void PerimeterGenerator::process_arachne(
     ExtrusionEntityCollection extrusion_coll = traverse_extrusions(params, lower_slices_polygons_cache,
                                                                    lower_slices_raw, ordered_extrusions);
     if (!extrusion_coll.empty())
-        out_loops.append(extrusion_coll);
+        out_loops.append(std::move(extrusion_coll));
 
     const coord_t spacing = (perimeters.size() == 1) ? ext_perimeter_spacing2 : perimeter_spacing;
     if (offset_ex(infill_contour, -float(spacing / 2.)).empty())
@@ -2469,7 +2469,7 @@ void PerimeterGenerator::process_classic(
         // append perimeters for this slice as a collection
         if (!entities.empty())
         {
-            out_loops.append(entities);
+            out_loops.append(std::move(entities));
         }
     } // for each loop of an island
 
@@ -2844,7 +2844,7 @@ void PerimeterGenerator::process_athena(
     if (ExtrusionEntityCollection extrusion_coll = traverse_extrusions(params, lower_slices_polygons_cache,
                                                                        lower_slices_raw, ordered_extrusions);
         !extrusion_coll.empty())
-        out_loops.append(extrusion_coll);
+        out_loops.append(std::move(extrusion_coll));
 
     // Note: Gap fill is intentionally not implemented for Athena (matches Arachne behavior)
 
@@ -42,17 +42,25 @@
 #include "format.hpp"
 #include "ArrangeHelper.hpp"
 #include "CustomParametersHandling.hpp"
+#include "libslic3r_version.h"
 
 #include <float.h>
 
 #include <algorithm>
 #include <limits>
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <boost/filesystem/path.hpp>
 #include <boost/format.hpp>
 #include <boost/log/trivial.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <boost/regex.hpp>
+#include <oneapi/tbb/flow_graph.h>
+#include <oneapi/tbb/task_arena.h>
+
+#include "nlohmann/json.hpp"
 
 namespace Slic3r
 {
@@ -1052,6 +1060,23 @@ void Print::auto_assign_extruders(ModelObject *model_object) const
     }
 }
 
+// Indices into m_objects sorted by a rough estimate of the slicing work (bounding box volume), largest first.
+std::vector<size_t> Print::objects_by_estimated_work() const
+{
+    std::vector<size_t> order(m_objects.size());
+    std::vector<double> work(m_objects.size());
+    for (size_t idx = 0; idx < m_objects.size(); ++idx)
+    {
+        const Vec3crd &size = m_objects[idx]->size();
+        order[idx] = idx;
+        work[idx] = double(size.x()) * double(size.y()) * double(size.z()) *
+                    double(std::max<size_t>(1, m_objects[idx]->num_printing_regions()));
+    }
+    // Stable sort keeps the object order for objects of the same size, so that the processing order is deterministic.
+    std::stable_sort(order.begin(), order.end(), [&work](size_t l, size_t r) { return work[l] > work[r]; });
+    return order;
+}
+
 // Slicing process, running at a background thread.
 void Print::process()
 {
@@ -1059,19 +1084,6 @@ void Print::process()
 
     BOOST_LOG_TRIVIAL(info) << "Starting the slicing process." << log_memory_info();
 
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_objects.size(), 1),
-        [this](const tbb::blocked_range<size_t> &range)
-        {
-            for (size_t idx = range.begin(); idx < range.end(); ++idx)
-            {
-                m_objects[idx]->make_perimeters();
-                m_objects[idx]->infill();
-                m_objects[idx]->ironing();
-            }
-        },
-        tbb::simple_partitioner());
-
     // The alert_when_supports_needed() function only processes objects WITHOUT support enabled,
     // so if all objects have support, we can skip both the search and the alert step entirely.
     bool any_object_needs_support_alerts = false;
@@ -1084,29 +1096,91 @@ void Print::process()
         }
     }
 
-    if (any_object_needs_support_alerts)
+    // The object steps are executed as a dependency graph, so that the support generation of one object
+    // does not wait for the perimeters and infill of all the other objects to finish:
+    //     slice -> make_perimeters -> infill -> ironing -> [generate_support_spots] ->
+    //     generate_support_material -> estimate_curled_extrusions -> calculate_overhanging_perimeters
+    // generate_support_spots() writes to the PrintObjectRegions shared by the instances of a single ModelObject.
+    // Only the first PrintObject sharing the regions calculates the support spots, the search of the other
+    // PrintObjects sharing the same regions waits for it. Objects with distinct regions run independently.
+    // Each object runs its steps as nested per-layer parallel_for loops, thus worker threads that finished
+    // the small objects steal layer ranges of the large ones. Start the largest objects first, so that
+    // a single tall object does not end up being processed last with the rest of the thread pool idle.
+    // Objects sharing their slices (see MeshSliceCache::SharedSlices) are sliced one after another, so that the objects
+    // transforming the slices of the first one never block a worker thread waiting for them.
     {
-        // The following step writes to m_shared_regions, it should not run in parallel.
+        using StepNode = tbb::flow::continue_node<tbb::flow::continue_msg>;
+        tbb::flow::graph                         graph;
+        std::vector<std::unique_ptr<StepNode>>   slice_nodes;
+        std::vector<std::unique_ptr<StepNode>>   shells_nodes;
+        std::vector<std::unique_ptr<StepNode>>   support_spots_nodes;
+        std::vector<std::unique_ptr<StepNode>>   support_nodes;
+        std::map<const PrintObjectRegions *, StepNode *> shared_regions_owner;
+        slice_nodes.reserve(m_objects.size());
+        shells_nodes.reserve(m_objects.size());
+        support_nodes.reserve(m_objects.size());
         for (PrintObject *obj : m_objects)
-            obj->generate_support_spots();
-        // check data from previous step, format the error message(s) and send alert to ui
-        // this also has to be done sequentially.
-        alert_when_supports_needed();
-    }
-
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_objects.size(), 1),
-        [this](const tbb::blocked_range<size_t> &range)
         {
-            for (size_t idx = range.begin(); idx < range.end(); ++idx)
+            slice_nodes.emplace_back(
+                std::make_unique<StepNode>(graph, [obj](const tbb::flow::continue_msg &) { obj->slice(); }));
+            shells_nodes.emplace_back(std::make_unique<StepNode>(graph,
+                                                                 [obj](const tbb::flow::continue_msg &)
+                                                                 {
+                                                                     obj->make_perimeters();
+                                                                     obj->infill();
+                                                                     obj->ironing();
+                                                                 }));
+            tbb::flow::make_edge(*slice_nodes.back(), *shells_nodes.back());
+            support_nodes.emplace_back(std::make_unique<StepNode>(graph,
+                                                                  [obj](const tbb::flow::continue_msg &)
+                                                                  {
+                                                                      obj->generate_support_material();
+                                                                      obj->estimate_curled_extrusions();
+                                                                      obj->calculate_overhanging_perimeters();
+                                                                  }));
+            if (any_object_needs_support_alerts)
             {
-                PrintObject &obj = *m_objects[idx];
-                obj.generate_support_material();
-                obj.estimate_curled_extrusions();
-                obj.calculate_overhanging_perimeters();
+                StepNode *spots = support_spots_nodes
+                                      .emplace_back(std::make_unique<StepNode>(graph,
+                                                                               [obj](const tbb::flow::continue_msg &)
+                                                                               { obj->generate_support_spots(); }))
+                                      .get();
+                tbb::flow::make_edge(*shells_nodes.back(), *spots);
+                tbb::flow::make_edge(*spots, *support_nodes.back());
+                if (auto [it, inserted] = shared_regions_owner.emplace(obj->shared_regions(), spots); !inserted)
+                    tbb::flow::make_edge(*it->second, *spots);
             }
-        },
-        tbb::simple_partitioner());
+            else
+                tbb::flow::make_edge(*shells_nodes.back(), *support_nodes.back());
+        }
+        std::vector<bool> slice_after_another(m_objects.size(), false);
+        if (m_objects.size() > 1)
+            for (const std::vector<size_t> &group : m_shared_slices.set_objects(m_objects))
+                for (size_t i = 1; i < group.size(); ++i)
+                {
+                    tbb::flow::make_edge(*slice_nodes[group[i - 1]], *slice_nodes[group[i]]);
+                    slice_after_another[group[i]] = true;
+                }
+        for (size_t idx : this->objects_by_estimated_work())
+            if (!slice_after_another[idx])
+                slice_nodes[idx]->try_put(tbb::flow::continue_msg());
+        // Rethrows the first exception (cancellation, slicing error) thrown by any of the steps.
+        try
+        {
+            graph.wait_for_all();
+        }
+        catch (...)
+        {
+            m_shared_slices.clear();
+            throw;
+        }
+        m_shared_slices.clear();
+    }
+
+    if (any_object_needs_support_alerts)
+        // check data from the support spots search, format the error message(s) and send alert to ui
+        // this has to be done sequentially.
+        alert_when_supports_needed();
 
     if (this->set_started(psWipeTower))
     {
@@ -1340,6 +1414,92 @@ std::string Print::export_gcode(const std::string &path_template, GCodeProcessor
     return path.c_str();
 }
 
+const char *step_name(PrintStep step)
+{
+    switch (step)
+    {
+    case psWipeTower: return "psWipeTower";
+    case psAlertWhenSupportsNeeded: return "psAlertWhenSupportsNeeded";
+    case psSkirtBrim: return "psSkirtBrim";
+    case psGCodeExport: return "psGCodeExport";
+    default: return "psUnknown";
+    }
+}
+
+const char *step_name(PrintObjectStep step)
+{
+    switch (step)
+    {
+    case posSlice: return "posSlice";
+    case posPerimeters: return "posPerimeters";
+    case posPrepareInfill: return "posPrepareInfill";
+    case posInfill: return "posInfill";
+    case posIroning: return "posIroning";
+    case posSupportSpotsSearch: return "posSupportSpotsSearch";
+    case posSupportMaterial: return "posSupportMaterial";
+    case posEstimateCurledExtrusions: return "posEstimateCurledExtrusions";
+    case posCalculateOverhangingPerimeters: return "posCalculateOverhangingPerimeters";
+    default: return "posUnknown";
+    }
+}
+
+void Print::export_telemetry(const std::string &path) const
+{
+    using json = nlohmann::json;
+    const std::vector<PrintTelemetry::Record> records = m_telemetry.records();
+
+    json sections = json::array();
+    for (const PrintTelemetry::Record &record : records)
+        sections.push_back({{"name", record.name},
+                            {"calls", record.calls},
+                            {"items", record.items},
+                            {"wall_time", record.wall_time},
+                            {"cpu_time", record.cpu_time},
+                            {"peak_memory", record.peak_memory}});
+
+    // Measured share of the slicing steps in the units of ProgressConfig::SlicingPhase: percent of the time
+    // of the steps always present (ProgressConfig::SlicingPhase::total_base()). posInfill runs posPrepareInfill
+    // before it is started, thus the steps do not overlap.
+    static constexpr const std::pair<const char *, const char *> progress_weights_map[] = {
+        {"posSlice", "slice_volumes"},
+        {"posPerimeters", "perimeters"},
+        {"posPrepareInfill", "prepare_infill"},
+        {"posInfill", "making_infill"},
+        {"psSkirtBrim", "skirt_brim"},
+        {"posSupportSpotsSearch", "support_spots"},
+        {"posSupportMaterial", "support_material"},
+        {"posEstimateCurledExtrusions", "curled_extrusions"},
+        {"posCalculateOverhangingPerimeters", "overhanging_perims"},
+        {"psAlertWhenSupportsNeeded", "supports_alert"},
+    };
+    static constexpr const size_t num_base_steps = 5;
+    auto wall_time = [&records](const char *name)
+    {
+        auto it = std::find_if(records.begin(), records.end(),
+                               [name](const PrintTelemetry::Record &record) { return record.name == name; });
+        return it == records.end() ? 0. : it->wall_time;
+    };
+    double total_base = 0.;
+    for (size_t i = 0; i < num_base_steps; ++i)
+        total_base += wall_time(progress_weights_map[i].first);
+    json progress_weights = json::object();
+    if (total_base > 0.)
+        for (const auto &[step, weight] : progress_weights_map)
+            progress_weights[weight] = 100. * wall_time(step) / total_base;
+
+    const json out = {{"version", SLIC3R_VERSION},
+                      {"objects", m_objects.size()},
+                      {"threads", tbb::this_task_arena::max_concurrency()},
+                      {"sections", std::move(sections)},
+                      {"progress_weights", std::move(progress_weights)}};
+
+    boost::nowide::ofstream file(path, std::ios::out | std::ios::trunc);
+    file << out.dump(4) << std::endl;
+    file.close();
+    if (!file)
+        throw Slic3r::RuntimeError(std::string("Failed to write telemetry to ") + path);
+}
+
 void Print::_make_skirt()
 {
     // First off we need to decide how tall the skirt must be.
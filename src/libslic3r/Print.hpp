@@ -29,6 +29,7 @@
 #include "BoundingBox.hpp"
 #include "ExtrusionEntityCollection.hpp"
 #include "Flow.hpp"
+#include "MeshSliceCache.hpp"
 #include "Point.hpp"
 #include "Slicing.hpp"
 #include "SupportSpotsGenerator.hpp"
@@ -104,6 +105,10 @@ enum PrintObjectStep : unsigned int
     posCount,
 };
 
+// Names of the steps, as reported by the PrintTelemetry.
+const char *step_name(PrintStep step);
+const char *step_name(PrintObjectStep step);
+
 // A PrintRegion object represents a group of volumes to print
 // sharing the same config (including the same assigned extruder(s))
 class PrintRegion
@@ -488,8 +493,14 @@ private:
     bool invalidate_state_by_config_options(const ConfigOptionResolver &old_config,
                                             const ConfigOptionResolver &new_config,
                                             const std::vector<t_config_option_key> &opt_keys);
+    // Invalidate steps based on a set of parameters of a single PrintRegion changed.
+    // If the perimeters are invalidated, only the layers containing the region will have their perimeters regenerated.
+    bool invalidate_state_by_region_config_options(const PrintRegion &region, const ConfigOptionResolver &old_config,
+                                                   const ConfigOptionResolver &new_config,
+                                                   const std::vector<t_config_option_key> &opt_keys);
     // If ! m_slicing_params.valid, recalculate.
     void update_slicing_parameters();
+    size_t telemetry_items() const override { return m_layers.size(); }
 
     // Called on main thread with stopped or paused background processing to let PrintObject release data for its milestones that were invalidated or canceled.
     void cleanup();
@@ -544,6 +555,11 @@ private:
     // this is set to true when LayerRegion->slices is split in top/internal/bottom
     // so that next call to make_perimeters() performs a union() before computing loops
     bool m_typed_slices = false;
+    // Set by make_perimeters() when all layers hold its output. Until the perimeters are invalidated by anything else
+    // than a change of region configs, make_perimeters() only regenerates the layers containing m_perimeters_dirty_regions,
+    // thus editing a layer range modifier does not regenerate perimeters of the whole object.
+    bool m_perimeters_reusable = false;
+    std::vector<const PrintRegion *> m_perimeters_dirty_regions;
 
     std::pair<FillAdaptive::OctreePtr, FillAdaptive::OctreePtr> m_adaptive_fill_octrees;
     FillLightning::GeneratorPtr m_lightning_generator;
@@ -711,6 +727,9 @@ public:
     // If preview_data is not null, the preview_data is filled in for the G-code visualization (not used by the command line Slic3r).
     std::string export_gcode(const std::string &path_template, GCodeProcessorResult *result,
                              ThumbnailsGeneratorCallback thumbnail_cb = nullptr);
+    // Write the telemetry collected by process() and export_gcode() into a JSON file.
+    // Throws Slic3r::RuntimeError if the file cannot be written.
+    void export_telemetry(const std::string &path) const;
 
     // methods for handling state
     bool is_step_done(PrintStep step) const { return Inherited::is_step_done(step); }
@@ -808,6 +827,8 @@ private:
     void _make_wipe_tower();
     void finalize_first_layer_convex_hull();
     void alert_when_supports_needed();
+    // Indices of m_objects ordered by the estimated amount of slicing work, largest first.
+    std::vector<size_t> objects_by_estimated_work() const;
 
     // Islands of objects and their supports extruded at the 1st layer.
     Polygons first_layer_islands() const;
@@ -845,6 +866,9 @@ private:
     // Estimated print time, filament consumed.
     PrintStatistics m_print_statistics;
 
+    // Slices shared by the PrintObjects sliced during process(), which differ just by their XY placement.
+    MeshSliceCache::SharedSlices m_shared_slices;
+
     mutable bool m_force_invalidation = false;
 
     // To allow GCode to set the Print's GCodeExport step status.
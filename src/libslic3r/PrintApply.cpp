@@ -794,7 +794,8 @@ int print_region_ref_cnt(const PrintRegion &r)
 // Returns false if this object needs to be resliced because regions were merged or split.
 bool verify_update_print_object_regions(ModelVolumePtrs model_volumes, const PrintRegionConfig &default_region_config,
                                         size_t num_extruders, PrintObjectRegions &print_object_regions,
-                                        const std::function<void(const PrintRegionConfig &, const PrintRegionConfig &,
+                                        const std::function<void(const PrintRegion &, const PrintRegionConfig &,
+                                                                 const PrintRegionConfig &,
                                                                  const t_config_option_keys &)> &callback_invalidate)
 {
     // Sort by ModelVolume ID.
@@ -875,7 +876,7 @@ bool verify_update_print_object_regions(ModelVolumePtrs model_volumes, const Pri
                         // Region is referenced for the first time. Just change its parameters.
                         // Stop the background process before assigning new configuration to the regions.
                         t_config_option_keys diff = region.region->config().diff(cfg);
-                        callback_invalidate(region.region->config(), cfg, diff);
+                        callback_invalidate(*region.region, region.region->config(), cfg, diff);
                         region.region->config_apply_only(cfg, diff, false);
                     }
                     else
@@ -905,7 +906,7 @@ bool verify_update_print_object_regions(ModelVolumePtrs model_volumes, const Pri
                     // Region is referenced for the first time. Just change its parameters.
                     // Stop the background process before assigning new configuration to the regions.
                     t_config_option_keys diff = region.region->config().diff(cfg);
-                    callback_invalidate(region.region->config(), cfg, diff);
+                    callback_invalidate(*region.region, region.region->config(), cfg, diff);
                     region.region->config_apply_only(cfg, diff, false);
                 }
                 else
@@ -936,7 +937,7 @@ bool verify_update_print_object_regions(ModelVolumePtrs model_volumes, const Pri
                     // Region is referenced for the first time. Just change its parameters.
                     // Stop the background process before assigning new configuration to the regions.
                     t_config_option_keys diff = region.region->config().diff(cfg);
-                    callback_invalidate(region.region->config(), cfg, diff);
+                    callback_invalidate(*region.region, region.region->config(), cfg, diff);
                     region.region->config_apply_only(cfg, diff, false);
                 }
                 else
@@ -1922,14 +1923,14 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
                          print_object.model_object()->volumes, m_default_region_config, num_extruders,
                          *print_object_regions,
                          [it_print_object, it_print_object_end,
-                          &update_apply_status](const PrintRegionConfig &old_config,
+                          &update_apply_status](const PrintRegion &region, const PrintRegionConfig &old_config,
                                                 const PrintRegionConfig &new_config,
                                                 const t_config_option_keys &diff_keys)
                          {
                              for (auto it = it_print_object; it != it_print_object_end; ++it)
                                  if ((*it)->m_shared_regions != nullptr)
-                                     update_apply_status(
-                                         (*it)->invalidate_state_by_config_options(old_config, new_config, diff_keys));
+                                     update_apply_status((*it)->invalidate_state_by_region_config_options(
+                                         region, old_config, new_config, diff_keys));
                          }))
             {
                 // Regions are valid, just keep them.
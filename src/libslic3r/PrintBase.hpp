@@ -7,17 +7,20 @@
 #define slic3r_PrintBase_hpp_
 
 #include "libslic3r.h"
+#include <array>
 #include <set>
 #include <vector>
 #include <string>
 #include <functional>
 #include <atomic>
 #include <mutex>
+#include <optional>
 
 #include "ObjectID.hpp"
 #include "Model.hpp"
 #include "PlaceholderParser.hpp"
 #include "PrintConfig.hpp"
+#include "PrintTelemetry.hpp"
 
 namespace Slic3r
 {
@@ -411,6 +414,8 @@ protected:
     // If no status callback is registered, the message is printed to console.
     void status_update_warnings(PrintBase *print, int step, PrintStateBase::WarningLevel warning_level,
                                 const std::string &message);
+    // Number of items (layers) processed by a step of this object, reported to the PrintTelemetry.
+    virtual size_t telemetry_items() const { return 0; }
 
     ModelObject *m_model_object;
 };
@@ -591,6 +596,9 @@ public:
     // If filename_set is empty, than the path may be a file or directory. If it is a file, then the macro will not be processed.
     std::string output_filepath(const std::string &path, const std::string &filename_base = std::string()) const;
 
+    // Performance telemetry of the processing steps, disabled by default.
+    PrintTelemetry &telemetry() const { return m_telemetry; }
+
 protected:
     friend class PrintObjectBase;
     friend class BackgroundSlicingProcess;
@@ -627,6 +635,8 @@ protected:
     // Callback to be evoked regularly to update state of the UI thread.
     status_callback_type m_status_callback;
 
+    mutable PrintTelemetry m_telemetry;
+
 private:
     std::atomic<CancelStatus> m_cancel_status;
 
@@ -663,12 +673,18 @@ public:
 protected:
     bool set_started(PrintStepEnum step)
     {
-        return m_state.set_started(step, this->state_mutex(), [this]() { this->throw_if_canceled(); });
+        if (!m_state.set_started(step, this->state_mutex(), [this]() { this->throw_if_canceled(); }))
+            return false;
+        m_step_start[step] = m_telemetry.enabled() ? std::make_optional(PrintTelemetry::sample()) : std::nullopt;
+        return true;
     }
     PrintStateBase::TimeStamp set_done(PrintStepEnum step)
     {
         std::pair<PrintStateBase::TimeStamp, bool> status = m_state.set_done(step, this->state_mutex(),
                                                                              [this]() { this->throw_if_canceled(); });
+        if (m_telemetry.enabled() && m_step_start[step])
+            m_telemetry.add(step_name(step), *m_step_start[step]);
+        m_step_start[step].reset();
         if (status.second)
             this->status_update_warnings(static_cast<int>(step), PrintStateBase::WarningLevel::NON_CRITICAL,
                                          std::string());
@@ -823,6 +839,8 @@ protected:
 
 private:
     PrintState<PrintStepEnum, COUNT> m_state;
+    // Start of the running steps, set if the telemetry was enabled when the step started.
+    std::array<std::optional<PrintTelemetry::Sample>, COUNT> m_step_start;
 };
 
 template<typename PrintType, typename PrintObjectStepEnumType, const size_t COUNT>
@@ -872,14 +890,20 @@ protected:
 
     bool set_started(PrintObjectStepEnum step)
     {
-        return m_state.set_started(step, PrintObjectBase::state_mutex(m_print),
-                                   [this]() { this->throw_if_canceled(); });
+        if (!m_state.set_started(step, PrintObjectBase::state_mutex(m_print), [this]() { this->throw_if_canceled(); }))
+            return false;
+        m_step_start[step] = m_print->telemetry().enabled() ? std::make_optional(PrintTelemetry::sample()) :
+                                                              std::nullopt;
+        return true;
     }
     PrintStateBase::TimeStamp set_done(PrintObjectStepEnum step)
     {
         std::pair<PrintStateBase::TimeStamp, bool> status = m_state.set_done(step,
                                                                              PrintObjectBase::state_mutex(m_print),
                                                                              [this]() { this->throw_if_canceled(); });
+        if (m_print->telemetry().enabled() && m_step_start[step])
+            m_print->telemetry().add(step_name(step), *m_step_start[step], this->telemetry_items());
+        m_step_start[step].reset();
         if (status.second)
             this->status_update_warnings(m_print, static_cast<int>(step), PrintStateBase::WarningLevel::NON_CRITICAL,
                                          std::string());
@@ -945,6 +969,8 @@ protected:
 
 private:
     PrintState<PrintObjectStepEnum, COUNT> m_state;
+    // Start of the running steps, set if the telemetry was enabled when the step started.
+    std::array<std::optional<PrintTelemetry::Sample>, COUNT> m_step_start;
 };
 
 } // namespace Slic3r
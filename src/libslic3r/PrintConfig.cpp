@@ -7075,6 +7075,32 @@ CLIMiscConfigDef::CLIMiscConfigDef()
         "Sets the maximum number of threads the slicing process will use. If not defined, it will be decided automatically.");
     def->min = 1;
 
+    def = this->add("batch", coString);
+    def->label = L("Batch manifest");
+    def->tooltip = L("Process slicing jobs listed in the given manifest file, or read from the standard input if \"-\" "
+                     "is given. Each line holds the command line arguments of a single job (input files, --output, "
+                     "--load and other options), which are combined with the options given on the command line. "
+                     "Empty lines and lines starting with # are skipped. Loaded configurations and profiles are "
+                     "reused between the jobs and a JSON report with the print statistics is written next to the "
+                     "output of each job.");
+
+    def = this->add("batch_jobs", coInt);
+    def->label = L("Concurrent batch jobs");
+    def->tooltip = L("Number of batch jobs processed concurrently.");
+    def->min = 1;
+
+    def = this->add("mesh_slice_cache_dir", coString);
+    def->label = L("Mesh slice cache directory");
+    def->tooltip = L("Store the mesh slices of the objects in the given directory and reuse them when the same model "
+                     "is sliced again with the same object and region settings. Only the slicing of the meshes "
+                     "is skipped, perimeters, infill and supports are still generated for every job.");
+
+    def = this->add("telemetry", coBool);
+    def->label = L("Export performance telemetry");
+    def->tooltip = L("Measure the wall clock time, CPU time and peak memory of the slicing steps and of the G-code "
+                     "export stages and write them into a JSON file next to the exported G-code.");
+    def->set_default_value(new ConfigOptionBool(false));
+
     def = this->add("loglevel", coInt);
     def->label = L("Logging level");
     def->tooltip = L("Sets logging sensitivity. 0:fatal, 1:error, 2:warning, 3:info, 4:debug, 5:trace\n"
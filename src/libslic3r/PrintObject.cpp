@@ -213,12 +213,17 @@ void PrintObject::make_perimeters()
     // Revert the typed slices into untyped slices.
     if (m_typed_slices)
     {
-        for (Layer *layer : m_layers)
-        {
-            layer->clear_fills();
-            layer->restore_untyped_slices();
-            m_print->throw_if_canceled();
-        }
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, m_layers.size()),
+                          [this](const tbb::blocked_range<size_t> &range)
+                          {
+                              for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx)
+                              {
+                                  m_print->throw_if_canceled();
+                                  m_layers[layer_idx]->clear_fills();
+                                  m_layers[layer_idx]->restore_untyped_slices();
+                              }
+                          });
+        m_print->throw_if_canceled();
         m_typed_slices = false;
     }
 
@@ -303,14 +308,38 @@ void PrintObject::make_perimeters()
     }
     report_progress(0.33f); // 33% - extra perimeters calculated
 
+    // If only some region configs changed since the last run, keep the perimeters of the layers not containing
+    // any of these regions. Perimeters of a layer depend on its own regions and on the slices of the neighbor layers,
+    // which did not change.
+    std::vector<unsigned char> layers_to_regenerate(m_layers.size(), true);
+    if (m_perimeters_reusable)
+    {
+        for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++layer_idx)
+            layers_to_regenerate[layer_idx] = std::any_of(
+                m_layers[layer_idx]->regions().begin(), m_layers[layer_idx]->regions().end(),
+                [this](const LayerRegion *layerm)
+                {
+                    return !layerm->slices().empty() &&
+                           std::find(m_perimeters_dirty_regions.begin(), m_perimeters_dirty_regions.end(),
+                                     &layerm->region()) != m_perimeters_dirty_regions.end();
+                });
+        BOOST_LOG_TRIVIAL(debug) << "Regenerating perimeters of "
+                                 << std::count(layers_to_regenerate.begin(), layers_to_regenerate.end(), true)
+                                 << " out of " << m_layers.size() << " layers";
+    }
+    // The layers will be modified, they may only be reused again after this step finishes.
+    m_perimeters_reusable = false;
+
     BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - start";
     tbb::parallel_for(tbb::blocked_range<size_t>(0, m_layers.size()),
-                      [this](const tbb::blocked_range<size_t> &range)
+                      [this, &layers_to_regenerate](const tbb::blocked_range<size_t> &range)
                       {
                           PRINT_OBJECT_TIME_LIMIT_MILLIS(PRINT_OBJECT_TIME_LIMIT_DEFAULT);
                           for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx)
                           {
                               m_print->throw_if_canceled();
+                              if (!layers_to_regenerate[layer_idx])
+                                  continue;
                               m_layers[layer_idx]->make_perimeters();
                               m_layers[layer_idx]->clear_visibility_cache();
                           }
@@ -321,6 +350,8 @@ void PrintObject::make_perimeters()
 
     Feature::FuzzySkin::clear_visibility_cache();
 
+    m_perimeters_dirty_regions.clear();
+    m_perimeters_reusable = true;
     this->set_done(posPerimeters);
 }
 
@@ -352,11 +383,16 @@ void PrintObject::prepare_infill()
         // The preceding step (perimeter generator) only modifies extra_perimeters and the extra perimeters are only used by discover_vertical_shells()
         // with more than a single region. If this step does not use Surface::extra_perimeters or Surface::extra_perimeters is always zero, it is safe
         // to reset to the untyped slices before re-runnning detect_surfaces_type().
-        for (Layer *layer : m_layers)
-        {
-            layer->restore_untyped_slices_no_extra_perimeters();
-            m_print->throw_if_canceled();
-        }
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, m_layers.size()),
+                          [this](const tbb::blocked_range<size_t> &range)
+                          {
+                              for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx)
+                              {
+                                  m_print->throw_if_canceled();
+                                  m_layers[layer_idx]->restore_untyped_slices_no_extra_perimeters();
+                              }
+                          });
+        m_print->throw_if_canceled();
     }
 
     // This will assign a type (top/bottom/internal) to $layerm->slices.
@@ -371,12 +407,19 @@ void PrintObject::prepare_infill()
     // Here the stTop / stBottomBridge / stBottom infill is turned to just stInternal if zero top / bottom infill layers are configured.
     // Also tiny stInternal surfaces are turned to stInternalSolid.
     BOOST_LOG_TRIVIAL(info) << "Preparing fill surfaces..." << log_memory_info();
-    for (auto *layer : m_layers)
-        for (auto *region : layer->m_regions)
-        {
-            region->prepare_fill_surfaces();
-            m_print->throw_if_canceled();
-        }
+    // Each LayerRegion only touches its own fill surfaces, so the layers are processed in parallel
+    // to keep the thread pool busy while other objects of the print are being processed.
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_layers.size()),
+                      [this](const tbb::blocked_range<size_t> &range)
+                      {
+                          for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++layer_idx)
+                          {
+                              m_print->throw_if_canceled();
+                              for (LayerRegion *region : m_layers[layer_idx]->m_regions)
+                                  region->prepare_fill_surfaces();
+                          }
+                      });
+    m_print->throw_if_canceled();
     report_progress(0.5f); // 50% - fill surfaces prepared
 
     // Add solid fills to ensure the shell vertical thickness.
@@ -765,6 +808,8 @@ void PrintObject::calculate_overhanging_perimeters()
 
         if (!regions_with_dynamic_speeds.empty())
         {
+            // The perimeters are modified in place, they no longer match the output of make_perimeters().
+            m_perimeters_reusable = false;
             std::unordered_map<size_t, AABBTreeLines::LinesDistancer<CurledLine>> curled_lines;
             std::unordered_map<size_t, AABBTreeLines::LinesDistancer<Linef>> unscaled_polygons_lines;
             for (const Layer *l : this->layers())
@@ -878,6 +923,7 @@ void PrintObject::clear_layers()
     for (Layer *l : m_layers)
         delete l;
     m_layers.clear();
+    m_perimeters_reusable = false;
 }
 
 Layer *PrintObject::add_layer(int id, coordf_t height, coordf_t print_z, coordf_t slice_z)
@@ -1135,9 +1181,31 @@ bool PrintObject::invalidate_state_by_config_options(const ConfigOptionResolver
     return invalidated;
 }
 
+// Called by Print::apply() for a PrintRegion of this object, which is not being split or merged.
+bool PrintObject::invalidate_state_by_region_config_options(const PrintRegion &region,
+                                                            const ConfigOptionResolver &old_config,
+                                                            const ConfigOptionResolver &new_config,
+                                                            const std::vector<t_config_option_key> &opt_keys)
+{
+    const bool perimeters_reusable = m_perimeters_reusable;
+    bool invalidated = this->invalidate_state_by_config_options(old_config, new_config, opt_keys);
+    if (perimeters_reusable && this->is_step_done_unguarded(posSlice))
+    {
+        // Layers were not resliced, only the perimeters of the layers containing this region need to be regenerated.
+        m_perimeters_reusable = true;
+        if (!this->is_step_done_unguarded(posPerimeters) &&
+            std::find(m_perimeters_dirty_regions.begin(), m_perimeters_dirty_regions.end(), &region) ==
+                m_perimeters_dirty_regions.end())
+            m_perimeters_dirty_regions.emplace_back(&region);
+    }
+    return invalidated;
+}
+
 bool PrintObject::invalidate_step(PrintObjectStep step)
 {
     bool invalidated = Inherited::invalidate_step(step);
+    if (step == posSlice || step == posPerimeters)
+        m_perimeters_reusable = false;
 
     // propagate to dependent steps
     if (step == posPerimeters)
@@ -1192,6 +1260,7 @@ bool PrintObject::invalidate_all_steps()
     bool result = Inherited::invalidate_all_steps() | m_print->invalidate_all_steps();
     // Then reset some of the depending values.
     m_slicing_params.valid = false;
+    m_perimeters_reusable = false;
     return result;
 }
 
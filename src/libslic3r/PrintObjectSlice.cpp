@@ -19,6 +19,7 @@
 #include "ElephantFootCompensation.hpp"
 #include "I18N.hpp"
 #include "Layer.hpp"
+#include "MeshSliceCache.hpp"
 #include "MultiMaterialSegmentation.hpp"
 #include "Print.hpp"
 #include "ProgressConfig.hpp"
@@ -1065,23 +1066,39 @@ void PrintObject::slice_volumes()
     }
 
     std::vector<float> slice_zs = zs_from_layers(m_layers);
-    std::vector<std::vector<ExPolygons>> region_slices = slices_to_regions(
-        this->model_object()->volumes, *m_shared_regions, slice_zs,
-        slice_volumes_inner(print->config(), this->config(), this->trafo_centered(), this->model_object()->volumes,
-                            m_shared_regions->layer_ranges, slice_zs, throw_on_cancel_callback),
-        throw_on_cancel_callback);
+    auto slice = [this, print, &slice_zs, &throw_on_cancel_callback]()
+    {
+        std::vector<std::vector<ExPolygons>> region_slices;
+        // Slices of a mesh / transformation / slicing config combination sliced by an earlier run are loaded
+        // from the mesh slice cache.
+        const std::string cache_key = MeshSliceCache::enabled() ? MeshSliceCache::key(*this, slice_zs) : std::string();
+        if (cache_key.empty() ||
+            !MeshSliceCache::load(cache_key, m_shared_regions->all_regions.size(), slice_zs.size(), region_slices))
+        {
+            region_slices = slices_to_regions(this->model_object()->volumes, *m_shared_regions, slice_zs,
+                                              slice_volumes_inner(print->config(), this->config(),
+                                                                  this->trafo_centered(), this->model_object()->volumes,
+                                                                  m_shared_regions->layer_ranges, slice_zs,
+                                                                  throw_on_cancel_callback),
+                                              throw_on_cancel_callback);
+            for (std::vector<ExPolygons> &by_layer : region_slices)
+                for (ExPolygons &expolygons : by_layer)
+                    if (!expolygons.empty())
+                        expolygons = union_ex(expolygons);
+            if (!cache_key.empty())
+                MeshSliceCache::store(cache_key, region_slices);
+        }
+        return region_slices;
+    };
+    // Copies of a part added as separate ModelObjects differ just by their placement on the bed:
+    // slice the first of them, transform its slices for the others.
+    std::vector<std::vector<ExPolygons>> region_slices = m_print->m_shared_slices.get_or_slice(*this, slice_zs, slice);
 
     for (size_t region_id = 0; region_id < region_slices.size(); ++region_id)
     {
         std::vector<ExPolygons> &by_layer = region_slices[region_id];
         for (size_t layer_id = 0; layer_id < by_layer.size(); ++layer_id)
-        {
-            if (!by_layer[layer_id].empty())
-            {
-                by_layer[layer_id] = union_ex(by_layer[layer_id]);
-            }
             m_layers[layer_id]->regions()[region_id]->m_slices.append(std::move(by_layer[layer_id]), stInternal);
-        }
     }
 
     region_slices.clear();
@@ -0,0 +1,52 @@
+///|/ Copyright (c) preFlight 2025+ oozeBot, LLC
+///|/
+///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
+///|/
+#include "PrintTelemetry.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Utils.hpp"
+
+namespace Slic3r
+{
+
+void PrintTelemetry::clear()
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_records.clear();
+}
+
+PrintTelemetry::Sample PrintTelemetry::sample(CpuTime cpu_time)
+{
+    return {std::chrono::steady_clock::now(), cpu_time == CpuTime::Process ? process_cpu_time() : thread_cpu_time()};
+}
+
+void PrintTelemetry::add(const char *name, const Sample &start, size_t items, CpuTime cpu_time)
+{
+    const Sample end = sample(cpu_time);
+    const size_t peak_memory = peak_memory_usage();
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_records.begin(), m_records.end(),
+                           [name](const Record &record) { return std::strcmp(record.name.c_str(), name) == 0; });
+    if (it == m_records.end())
+    {
+        m_records.emplace_back();
+        it = std::prev(m_records.end());
+        it->name = name;
+    }
+    ++it->calls;
+    it->items += items;
+    it->wall_time += std::chrono::duration<double>(end.wall - start.wall).count();
+    it->cpu_time += std::max(0., end.cpu - start.cpu);
+    it->peak_memory = std::max(it->peak_memory, peak_memory);
+}
+
+std::vector<PrintTelemetry::Record> PrintTelemetry::records() const
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    return m_records;
+}
+
+} // namespace Slic3r
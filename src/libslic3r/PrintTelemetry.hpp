@@ -0,0 +1,102 @@
+///|/ Copyright (c) preFlight 2025+ oozeBot, LLC
+///|/
+///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
+///|/
+#ifndef slic3r_PrintTelemetry_hpp_
+#define slic3r_PrintTelemetry_hpp_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Slic3r
+{
+
+// Performance telemetry of the Print / PrintObject steps and of the G-code export stages.
+// Measurements of a section with the same name are accumulated, for example a PrintObjectStep executed
+// for multiple PrintObjects or a G-code pipeline stage executed for every layer.
+// The telemetry is disabled by default, then measuring a section costs just a test of an atomic flag.
+class PrintTelemetry
+{
+public:
+    struct Record
+    {
+        std::string name;
+        // Number of times the section was executed.
+        size_t calls{0};
+        // Number of items (layers) processed by the section.
+        size_t items{0};
+        // Sum of the wall clock times of all the executions, in seconds.
+        // Sections executed concurrently (steps of multiple objects, parallel pipeline stages) overlap.
+        double wall_time{0.};
+        // CPU time in seconds, either of the whole process while the section was running (steps
+        // running parallel loops), or of the thread executing the section (G-code pipeline stages).
+        double cpu_time{0.};
+        // Peak resident memory of the process at the end of the section, in bytes.
+        size_t peak_memory{0};
+    };
+
+    enum class CpuTime
+    {
+        Process,
+        Thread,
+    };
+
+    struct Sample
+    {
+        std::chrono::steady_clock::time_point wall;
+        double cpu{0.};
+    };
+
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void set_enabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    void clear();
+
+    static Sample sample(CpuTime cpu_time = CpuTime::Process);
+    // Accumulate a section started at the time of the start sample. Thread safe.
+    void add(const char *name, const Sample &start, size_t items = 0, CpuTime cpu_time = CpuTime::Process);
+    // Records in the order the sections were first finished.
+    std::vector<Record> records() const;
+
+    // Measure the lifetime of the Scope object, if the telemetry is enabled.
+    class Scope
+    {
+    public:
+        Scope(const PrintTelemetry &telemetry, const char *name, size_t items = 0,
+              CpuTime cpu_time = CpuTime::Thread)
+            : m_telemetry(telemetry.enabled() ? const_cast<PrintTelemetry *>(&telemetry) : nullptr)
+            , m_name(name)
+            , m_items(items)
+            , m_cpu_time(cpu_time)
+        {
+            if (m_telemetry)
+                m_start = PrintTelemetry::sample(m_cpu_time);
+        }
+        ~Scope()
+        {
+            if (m_telemetry)
+                m_telemetry->add(m_name, m_start, m_items, m_cpu_time);
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        PrintTelemetry *m_telemetry;
+        const char *m_name;
+        size_t m_items;
+        CpuTime m_cpu_time;
+        Sample m_start;
+    };
+
+private:
+    std::atomic<bool> m_enabled{false};
+    mutable std::mutex m_mutex;
+    std::vector<Record> m_records;
+};
+
+} // namespace Slic3r
+
+#endif // slic3r_PrintTelemetry_hpp_
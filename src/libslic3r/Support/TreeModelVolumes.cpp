@@ -999,13 +999,36 @@ coord_t TreeModelVolumes::ceilRadius(const coord_t radius) const
     return out;
 }
 
-void TreeModelVolumes::RadiusLayerPolygonCache::allocate_layers(size_t num_layers)
+void TreeModelVolumes::RadiusLayerPolygonCache::allocate_layers(Layers &layers, size_t num_layers)
 {
-    if (num_layers > m_data.size())
+    if (num_layers > layers.size())
     {
-        if (num_layers > m_data.capacity())
-            reserve_power_of_2(m_data, num_layers);
-        m_data.resize(num_layers, {});
+        if (num_layers > layers.capacity())
+            reserve_power_of_2(layers, num_layers);
+        layers.resize(num_layers, {});
+    }
+}
+
+void TreeModelVolumes::RadiusLayerPolygonCache::clear_all_but_radius0()
+{
+    m_max_calculated_layer.clear();
+    for (size_t shard_id = 0; shard_id < NumShards; ++shard_id)
+    {
+        Layers &layers = m_shards[shard_id].layers;
+        for (size_t idx = 0; idx < layers.size(); ++idx)
+        {
+            LayerData &l = layers[idx];
+            auto begin = l.begin();
+            auto end = l.end();
+            if (begin != end && ++begin != end)
+                l.erase(begin, end);
+            if (!l.empty())
+            {
+                const LayerIndex layer_idx = LayerIndex(shard_id + NumShards * idx);
+                LayerIndex &max_layer = m_max_calculated_layer[l.begin()->first];
+                max_layer = std::max(max_layer, layer_idx);
+            }
+        }
     }
 }
 
@@ -1014,12 +1037,13 @@ std::vector<std::pair<TreeModelVolumes::RadiusLayerPair, std::reference_wrapper<
 TreeModelVolumes::RadiusLayerPolygonCache::sorted() const
 {
     std::vector<std::pair<RadiusLayerPair, std::reference_wrapper<const Polygons>>> out;
-    for (auto &layer : m_data)
-    {
-        auto layer_idx = LayerIndex(&layer - m_data.data());
-        for (auto &radius_polygons : layer)
-            out.emplace_back(std::make_pair(radius_polygons.first, layer_idx), radius_polygons.second);
-    }
+    size_t num_layers = 0;
+    for (const Shard &shard : m_shards)
+        num_layers = std::max(num_layers, shard.layers.size() * NumShards);
+    for (size_t layer_idx = 0; layer_idx < num_layers; ++layer_idx)
+        if (const LayerData *layer = layer_data(this->shard(LayerIndex(layer_idx)), LayerIndex(layer_idx)))
+            for (auto &radius_polygons : *layer)
+                out.emplace_back(std::make_pair(radius_polygons.first, LayerIndex(layer_idx)), radius_polygons.second);
     assert(std::is_sorted(out.begin(), out.end(),
                           [](auto &l, auto &r)
                           {
@@ -18,11 +18,15 @@
 #include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <algorithm>
+#include <array>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <functional>
 #include <map>
 #include <optional>
+#include <tuple>
 #include <utility>
 #include <vector>
 #include <cassert>
@@ -232,12 +236,25 @@ private:
         // Reference to Polygons returned shall be stable to insertion.
         using Layers = std::vector<LayerData>;
 
+        // The caches are queried and filled from all the TBB workers. The layers are interleaved into shards
+        // (layer_idx % NumShards), each guarded by its own reader / writer lock, so that lookups run concurrently
+        // and the workers inserting neighbor layers do not serialize on a single mutex.
+        static constexpr size_t NumShards = 16;
+        struct Shard
+        {
+            // Layers layer_idx = shard_idx + NumShards * i
+            Layers layers;
+            mutable std::shared_mutex mutex;
+        };
+
     public:
         RadiusLayerPolygonCache() = default;
-        RadiusLayerPolygonCache(RadiusLayerPolygonCache &&rhs) : m_data(std::move(rhs.m_data)) {}
+        RadiusLayerPolygonCache(RadiusLayerPolygonCache &&rhs) { *this = std::move(rhs); }
         RadiusLayerPolygonCache &operator=(RadiusLayerPolygonCache &&rhs)
         {
-            m_data = std::move(rhs.m_data);
+            for (size_t i = 0; i < NumShards; ++i)
+                m_shards[i].layers = std::move(rhs.m_shards[i].layers);
+            m_max_calculated_layer = std::move(rhs.m_max_calculated_layer);
             return *this;
         }
 
@@ -246,31 +263,26 @@ private:
 
         void insert(std::vector<std::pair<RadiusLayerPair, Polygons>> &&in)
         {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            for (auto &d : in)
-                this->get_allocate_layer_data(d.first.second).emplace(d.first.first, std::move(d.second));
+            this->insert_sharded(in.size(), [&in](size_t i)
+                                 { return std::make_tuple(in[i].first.second, in[i].first.first, &in[i].second); });
         }
         // by layer
         void insert(std::vector<std::pair<coord_t, Polygons>> &&in, coord_t radius)
         {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            for (auto &d : in)
-                this->get_allocate_layer_data(d.first).emplace(radius, std::move(d.second));
+            this->insert_sharded(in.size(), [&in, radius](size_t i)
+                                 { return std::make_tuple(LayerIndex(in[i].first), radius, &in[i].second); });
         }
         void insert(std::vector<Polygons> &&in, coord_t first_layer_idx, coord_t radius)
         {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            allocate_layers(first_layer_idx + in.size());
-            for (auto &d : in)
-                m_data[first_layer_idx++].emplace(radius, std::move(d));
+            this->insert_sharded(in.size(), [&in, first_layer_idx, radius](size_t i)
+                                 { return std::make_tuple(LayerIndex(first_layer_idx + i), radius, &in[i]); });
         }
         void insert(LayerPolygonCache &&in, coord_t radius)
         {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            LayerIndex i = in.begin();
-            allocate_layers(i + LayerIndex(in.size()));
-            for (auto &d : in.polygons_mutable())
-                m_data[i++].emplace(radius, std::move(d));
+            std::vector<Polygons> &polygons = in.polygons_mutable();
+            this->insert_sharded(polygons.size(),
+                                 [&polygons, first_layer_idx = in.begin(), radius](size_t i)
+                                 { return std::make_tuple(LayerIndex(first_layer_idx + i), radius, &polygons[i]); });
         }
         /*!
          * \brief Checks a cache for a given RadiusLayerPair and returns it if it is found
@@ -279,14 +291,14 @@ private:
          */
         std::optional<std::reference_wrapper<const Polygons>> getArea(const TreeModelVolumes::RadiusLayerPair &key) const
         {
-            std::lock_guard<std::mutex> guard(m_mutex);
+            const Shard &shard = this->shard(key.second);
+            std::shared_lock<std::shared_mutex> guard(shard.mutex);
 
-            if (key.second >= LayerIndex(m_data.size()))
+            const LayerData *layer = this->layer_data(shard, key.second);
+            if (layer == nullptr)
                 return std::nullopt;
-
-            const LayerData &layer = m_data[key.second];
-            auto it = layer.find(key.first);
-            if (it == layer.end())
+            auto it = layer->find(key.first);
+            if (it == layer->end())
                 return std::nullopt;
 
             return std::optional<std::reference_wrapper<const Polygons>>{it->second};
@@ -295,16 +307,15 @@ private:
         std::optional<std::pair<coord_t, std::reference_wrapper<const Polygons>>> get_lower_bound_area(
             const TreeModelVolumes::RadiusLayerPair &key) const
         {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            if (key.second >= LayerIndex(m_data.size()))
+            const Shard &shard = this->shard(key.second);
+            std::shared_lock<std::shared_mutex> guard(shard.mutex);
+            const LayerData *layer = this->layer_data(shard, key.second);
+            if (layer == nullptr || layer->empty())
                 return {};
-            const auto &layer = m_data[key.second];
-            if (layer.empty())
-                return {};
-            auto it = layer.lower_bound(key.first);
-            if (it == layer.end() || it->first != key.first)
+            auto it = layer->lower_bound(key.first);
+            if (it == layer->end() || it->first != key.first)
             {
-                if (it == layer.begin())
+                if (it == layer->begin())
                     return {};
                 --it;
             }
@@ -319,40 +330,72 @@ private:
          */
         LayerIndex getMaxCalculatedLayer(coord_t radius) const
         {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            auto layer_idx = LayerIndex(m_data.size()) - 1;
-            for (; layer_idx > 0; --layer_idx)
-                if (const auto &layer = m_data[layer_idx]; layer.find(radius) != layer.end())
-                    break;
+            std::shared_lock<std::shared_mutex> guard(m_max_calculated_layer_mutex);
+            auto it = m_max_calculated_layer.find(radius);
             // The placeable on model areas do not exist on layer 0, as there can not be model below it. As such it may be possible that layer 1 is available, but layer 0 does not exist.
-            return layer_idx == 0 ? -1 : layer_idx;
+            return it == m_max_calculated_layer.end() || it->second == 0 ? -1 : it->second;
         }
 
         // For debugging purposes, sorted by layer index, then by radius.
         [[nodiscard]] std::vector<std::pair<RadiusLayerPair, std::reference_wrapper<const Polygons>>> sorted() const;
 
-        void clear() { m_data.clear(); }
-        void clear_all_but_radius0()
+        void clear()
         {
-            for (LayerData &l : m_data)
-            {
-                auto begin = l.begin();
-                auto end = l.end();
-                if (begin != end && ++begin != end)
-                    l.erase(begin, end);
-            }
+            for (Shard &shard : m_shards)
+                shard.layers.clear();
+            m_max_calculated_layer.clear();
         }
+        void clear_all_but_radius0();
 
     private:
-        LayerData &get_allocate_layer_data(LayerIndex layer_idx)
+        static size_t shard_idx(LayerIndex layer_idx) { return size_t(layer_idx) % NumShards; }
+        static size_t idx_in_shard(LayerIndex layer_idx) { return size_t(layer_idx) / NumShards; }
+        const Shard &shard(LayerIndex layer_idx) const { return m_shards[shard_idx(layer_idx)]; }
+        // Shared lock of the shard has to be held.
+        static const LayerData *layer_data(const Shard &shard, LayerIndex layer_idx)
         {
-            allocate_layers(layer_idx + 1);
-            return m_data[layer_idx];
+            const size_t idx = idx_in_shard(layer_idx);
+            return idx < shard.layers.size() ? &shard.layers[idx] : nullptr;
+        }
+
+        // Insert polygons of items i in <0, num), where item(i) returns tuple (layer_idx, radius, Polygons*).
+        // Each shard touched is locked once for all its items.
+        template<typename GetItem>
+        void insert_sharded(size_t num, GetItem &&item)
+        {
+            if (num == 0)
+                return;
+            std::array<bool, NumShards> touched{};
+            for (size_t i = 0; i < num; ++i)
+                touched[shard_idx(std::get<0>(item(i)))] = true;
+            for (size_t shard_id = 0; shard_id < NumShards; ++shard_id)
+                if (touched[shard_id])
+                {
+                    Shard &shard = m_shards[shard_id];
+                    std::unique_lock<std::shared_mutex> guard(shard.mutex);
+                    for (size_t i = 0; i < num; ++i)
+                        if (auto [layer_idx, radius, polygons] = item(i); shard_idx(layer_idx) == shard_id)
+                        {
+                            const size_t idx = idx_in_shard(layer_idx);
+                            allocate_layers(shard.layers, idx + 1);
+                            shard.layers[idx].emplace(radius, std::move(*polygons));
+                        }
+                }
+            std::unique_lock<std::shared_mutex> guard(m_max_calculated_layer_mutex);
+            for (size_t i = 0; i < num; ++i)
+            {
+                auto [layer_idx, radius, polygons] = item(i);
+                auto [it, inserted] = m_max_calculated_layer.emplace(radius, layer_idx);
+                if (!inserted)
+                    it->second = std::max(it->second, layer_idx);
+            }
         }
-        void allocate_layers(size_t num_layers);
+        static void allocate_layers(Layers &layers, size_t num_layers);
 
-        Layers m_data;
-        mutable std::mutex m_mutex;
+        std::array<Shard, NumShards> m_shards;
+        // Highest layer inserted per radius.
+        std::map<coord_t, LayerIndex> m_max_calculated_layer;
+        mutable std::shared_mutex m_max_calculated_layer_mutex;
     };
 
     /*!
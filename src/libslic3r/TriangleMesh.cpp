@@ -17,6 +17,8 @@
 #include <libqhullcpp/Qhull.h>
 #include <libqhullcpp/QhullFacetList.h>
 #include <libqhullcpp/QhullVertexSet.h>
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/nowide/cstdio.hpp>
 #include <boost/predef/other/endian.h>
@@ -27,10 +29,15 @@
 #include <oneapi/tbb/blocked_range.h>
 #include <oneapi/tbb/concurrent_vector.h>
 #include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/parallel_reduce.h>
+#include <fast_float.h>
 #include <cmath>
 #include <vector>
 #include <utility>
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <system_error>
 #include <iterator>
 #include <map>
 #include <cstdio>
@@ -226,10 +233,287 @@ void TriangleMesh::from_facets(std::vector<stl_facet> &&facets, bool repair)
     fill_initial_stats(this->its, this->m_stats);
 }
 
+// Reader of memory mapped STL files, filling in stl.facet_start in parallel.
+namespace StlMapped
+{
+
+static constexpr size_t chunk_size = 4 * 1024 * 1024;
+
+static inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+static inline const char *skip_blanks(const char *p, const char *end)
+{
+    while (p != end && is_blank(*p))
+        ++p;
+    return p;
+}
+
+static inline const char *skip_line(const char *p, const char *end)
+{
+    while (p != end && *p != '\n')
+        ++p;
+    return p;
+}
+
+// Is there a keyword at p followed by a white space or the end of the file?
+static inline bool starts_with_keyword(const char *p, const char *end, const char *word, size_t len)
+{
+    return size_t(end - p) >= len && strncmp(p, word, len) == 0 && (p + len == end || is_blank(p[len]));
+}
+
+// Match a keyword at p, skip the white spaces after it.
+static inline bool keyword(const char *&p, const char *end, const char *word, size_t len)
+{
+    if (!starts_with_keyword(p, end, word, len))
+        return false;
+    p = skip_blanks(p + len, end);
+    return true;
+}
+
+static inline bool parse_float(const char *&p, const char *end, float &out)
+{
+    // fast_float does not accept the leading plus sign, which fscanf("%f") does.
+    const char *first = p != end && *p == '+' ? p + 1 : p;
+    auto [pend, ec] = fast_float::from_chars(first, end, out);
+    if (pend == first || ec != std::errc() || (pend != end && !is_blank(*pend)))
+        return false;
+    p = skip_blanks(pend, end);
+    return true;
+}
+
+// Parse one "facet normal ... endfacet" block starting at p, which points to the "facet" keyword.
+static bool parse_ascii_facet(const char *&p, const char *end, stl_facet &facet)
+{
+    if (!keyword(p, end, "facet", 5) || !keyword(p, end, "normal", 6))
+        return false;
+    for (int i = 0; i < 3; ++i)
+        if (!parse_float(p, end, facet.normal(i)))
+        {
+            // Normal was mangled. Maybe denormals or "not a number" were stored?
+            // Just reset the normal and silently ignore it, same as admesh.
+            facet.normal = stl_normal::Zero();
+            for (; i < 3; ++i)
+                p = skip_blanks(std::find_if(p, end, is_blank), end);
+            break;
+        }
+    if (!keyword(p, end, "outer", 5) || !keyword(p, end, "loop", 4))
+        return false;
+    for (int j = 0; j < 3; ++j)
+    {
+        if (!keyword(p, end, "vertex", 6))
+            return false;
+        for (int i = 0; i < 3; ++i)
+            if (!parse_float(p, end, facet.vertex[j](i)))
+                return false;
+    }
+    // Some exporters tend to produce text after "endloop" and "endfacet". Just ignore it.
+    if (!starts_with_keyword(p, end, "endloop", 7))
+        return false;
+    p = skip_blanks(skip_line(p, end), end);
+    if (!starts_with_keyword(p, end, "endfacet", 8))
+        return false;
+    p = skip_line(p, end);
+    return true;
+}
+
+// Start of the first line at or after p starting with the "facet" keyword, pointing to the keyword.
+static const char *find_facet_start(const char *p, const char *end)
+{
+    for (;;)
+    {
+        p = skip_line(p, end);
+        if (p == end)
+            return end;
+        const char *start = ++p;
+        while (start != end && (*start == ' ' || *start == '\t'))
+            ++start;
+        if (starts_with_keyword(start, end, "facet", 5))
+            return start;
+    }
+}
+
+static bool read_ascii(stl_file &stl, const char *data, const char *data_end)
+{
+    size_t header_len = 0;
+    for (; header_len < LABEL_SIZE && data[header_len] != '\n'; ++header_len)
+        ;
+    memcpy(stl.stats.header, data, header_len);
+    stl.stats.header[header_len] = '\0';
+
+    // Split the file into chunks, each starting with a "facet" line. The last facet of a chunk may extend
+    // over the end of the chunk.
+    std::vector<const char *> chunk_begins{data};
+    for (const char *p = data + chunk_size; p < data_end; p += chunk_size)
+        chunk_begins.emplace_back(std::max(chunk_begins.back(), find_facet_start(p, data_end)));
+    chunk_begins.emplace_back(data_end);
+
+    std::vector<std::vector<stl_facet>> chunk_facets(chunk_begins.size() - 1);
+    std::atomic<bool> failed{false};
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, chunk_facets.size(), 1),
+                      [&](const tbb::blocked_range<size_t> &range)
+                      {
+                          for (size_t chunk_idx = range.begin(); chunk_idx < range.end() && !failed; ++chunk_idx)
+                          {
+                              const char *chunk_end = chunk_begins[chunk_idx + 1];
+                              std::vector<stl_facet> &facets = chunk_facets[chunk_idx];
+                              facets.reserve((chunk_end - chunk_begins[chunk_idx]) / 250);
+                              for (const char *p = skip_blanks(chunk_begins[chunk_idx], data_end); p < chunk_end;
+                                   p = skip_blanks(p, data_end))
+                              {
+                                  // Skip solid / endsolid lines as broken STL file generators may put several
+                                  // of them. The solid name may contain spaces or it may be empty.
+                                  if (starts_with_keyword(p, data_end, "solid", 5) ||
+                                      starts_with_keyword(p, data_end, "endsolid", 8))
+                                  {
+                                      p = skip_line(p, data_end);
+                                      continue;
+                                  }
+                                  stl_facet facet;
+                                  memset(facet.extra, 0, sizeof(facet.extra));
+                                  if (!parse_ascii_facet(p, data_end, facet))
+                                  {
+                                      failed = true;
+                                      break;
+                                  }
+                                  facets.emplace_back(facet);
+                              }
+                          }
+                      });
+    if (failed)
+        return false;
+
+    std::vector<size_t> chunk_offsets(chunk_facets.size() + 1, 0);
+    for (size_t i = 0; i < chunk_facets.size(); ++i)
+        chunk_offsets[i + 1] = chunk_offsets[i] + chunk_facets[i].size();
+    stl.stats.type = ascii;
+    stl.stats.number_of_facets = uint32_t(chunk_offsets.back());
+    stl.stats.original_num_facets = int(stl.stats.number_of_facets);
+    stl_allocate(&stl);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, chunk_facets.size(), 1),
+                      [&](const tbb::blocked_range<size_t> &range)
+                      {
+                          for (size_t i = range.begin(); i < range.end(); ++i)
+                          {
+                              std::copy(chunk_facets[i].begin(), chunk_facets[i].end(),
+                                        stl.facet_start.begin() + chunk_offsets[i]);
+                              std::vector<stl_facet>().swap(chunk_facets[i]);
+                          }
+                      });
+    return true;
+}
+
+static void read_binary(stl_file &stl, const char *data, size_t file_size)
+{
+    const uint32_t num_facets = uint32_t((file_size - HEADER_SIZE) / SIZEOF_STL_FACET);
+    memcpy(stl.stats.header, data, LABEL_SIZE);
+    stl.stats.header[LABEL_SIZE] = '\0';
+    uint32_t header_num_facets;
+    memcpy(&header_num_facets, data + LABEL_SIZE, sizeof(uint32_t));
+    if (num_facets != header_num_facets)
+        BOOST_LOG_TRIVIAL(info) << "ReadSTLFile: Warning: File size doesn't match number of facets in the header";
+
+    stl.stats.type = binary;
+    stl.stats.number_of_facets = num_facets;
+    stl.stats.original_num_facets = int(num_facets);
+    stl_allocate(&stl);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_facets, chunk_size / SIZEOF_STL_FACET),
+                      [&stl, src = data + HEADER_SIZE](const tbb::blocked_range<size_t> &range)
+                      {
+                          for (size_t i = range.begin(); i < range.end(); ++i)
+                              memcpy(&stl.facet_start[i], src + i * SIZEOF_STL_FACET, SIZEOF_STL_FACET);
+                      });
+}
+
+// Bounding box of the facets, same as collected by admesh stl_facet_stats().
+// Returns false if any vertex contains an invalid coordinate.
+static bool update_stats(stl_file &stl)
+{
+    if (stl.facet_start.empty())
+        return true;
+    struct Stats
+    {
+        stl_vertex min{stl_vertex::Constant(std::numeric_limits<float>::max())};
+        stl_vertex max{stl_vertex::Constant(std::numeric_limits<float>::lowest())};
+        bool valid{true};
+    };
+    const Stats stats = tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, stl.facet_start.size()), Stats{},
+        [&stl](const tbb::blocked_range<size_t> &range, Stats stats)
+        {
+            for (size_t i = range.begin(); i < range.end(); ++i)
+                for (const stl_vertex &v : stl.facet_start[i].vertex)
+                {
+                    stats.valid &= v.allFinite();
+                    stats.min = stats.min.cwiseMin(v);
+                    stats.max = stats.max.cwiseMax(v);
+                }
+            return stats;
+        },
+        [](Stats a, const Stats &b)
+        {
+            a.valid &= b.valid;
+            a.min = a.min.cwiseMin(b.min);
+            a.max = a.max.cwiseMax(b.max);
+            return a;
+        });
+    if (!stats.valid)
+        return false;
+    const stl_facet &first = stl.facet_start.front();
+    stl.stats.min = stats.min;
+    stl.stats.max = stats.max;
+    stl.stats.shortest_edge = (first.vertex[1] - first.vertex[0]).cwiseAbs().maxCoeff();
+    stl.stats.size = stl.stats.max - stl.stats.min;
+    stl.stats.bounding_diameter = stl.stats.size.norm();
+    return true;
+}
+
+// Same result as admesh stl_open(), but the file is memory mapped and parsed in parallel.
+// Returns false if the file could not be mapped or if it is not a well formed STL file, then the caller
+// shall fall back to stl_open(), which reports the errors and tolerates some broken files.
+static bool open(stl_file &stl, const char *path)
+{
+#if BOOST_ENDIAN_BIG_BYTE
+    return false;
+#else
+    boost::system::error_code ec;
+    const boost::uintmax_t file_size = boost::filesystem::file_size(path, ec);
+    if (ec || file_size < HEADER_SIZE + 128)
+        return false;
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+        file.open(boost::filesystem::path(path));
+    }
+    catch (const std::exception &ex)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Failed to memory map " << path << ": " << ex.what()
+                                   << ", falling back to sequential reading.";
+    }
+    if (!file.is_open())
+        return false;
+
+    const char *data = file.data();
+    stl.clear();
+    // Check for binary or ASCII file the same way as admesh does.
+    if (std::any_of(data + HEADER_SIZE, data + HEADER_SIZE + 128, [](char c) { return (unsigned char) c > 127; }))
+    {
+        // Test if the STL file has the right size.
+        if ((file.size() - HEADER_SIZE) % SIZEOF_STL_FACET != 0 || file.size() < STL_MIN_FILE_SIZE)
+            return false;
+        read_binary(stl, data, file.size());
+    }
+    else if (!read_ascii(stl, data, data + file.size()))
+        return false;
+    return update_stats(stl);
+#endif
+}
+
+} // namespace StlMapped
+
 bool TriangleMesh::ReadSTLFile(const char *input_file, bool repair)
 {
     stl_file stl;
-    if (!stl_open(&stl, input_file))
+    if (!StlMapped::open(stl, input_file) && !stl_open(&stl, input_file))
         return false;
     if (repair)
         trianglemesh_repair_on_import(stl);
@@ -4,13 +4,12 @@
 ///|/ preFlight is based on PrusaSlicer and released under AGPLv3 or higher
 ///|/
 #include <boost/log/trivial.hpp>
-#include <ankerl/unordered_dense.h>
 #include <oneapi/tbb/blocked_range.h>
 #include <oneapi/tbb/parallel_for.h>
 #include <oneapi/tbb/scalable_allocator.h>
+#include <oneapi/tbb/task_arena.h>
 #include <algorithm>
 #include <cmath>
-#include <mutex>
 #include <utility>
 #include <array>
 #include <iterator>
@@ -38,15 +37,6 @@
 // #define SLIC3R_TRIANGLEMESH_DEBUG
 #endif
 
-#include <boost/thread/lock_guard.hpp>
-
-#if defined(__cpp_lib_hardware_interference_size) && !defined(__APPLE__)
-using std::hardware_destructive_interference_size;
-#else
-// 64 bytes on x86-64 │ L1_CACHE_BYTES │ L1_CACHE_SHIFT │ __cacheline_aligned │ ...
-constexpr std::size_t hardware_destructive_interference_size = 64;
-#endif
-
 // #define SLIC3R_DEBUG_SLICE_PROCESSING
 
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
@@ -447,30 +437,94 @@ inline FacetSliceType slice_facet(
     return FacetSliceType::NoSlice;
 }
 
-class LinesMutexes
+// IntersectionLines produced by slicing a range of facets, binned by slices.
+// Each range of facets is sliced by a single task into its own bin, thus no locking is needed.
+// The bins only span the slices touched by their facets and they are merged into the per slice
+// lines by merge_intersection_lines_bins() once all the facets are sliced.
+class IntersectionLinesBin
 {
 public:
-    std::mutex &operator()(size_t slice_id)
+    void emplace_back(size_t slice_id, const IntersectionLine &il)
     {
-        ankerl::unordered_dense::hash<size_t> hash;
-        return m_mutexes[hash(slice_id) % m_mutexes.size()].mutex;
+        if (m_lines.empty())
+            m_first_slice = slice_id;
+        else if (slice_id < m_first_slice)
+        {
+            // Grow the front geometrically, so that facets going downwards in the order of their indices
+            // do not shift the bin for each slice. Moving the IntersectionLines vectors is cheap.
+            const size_t grow = std::min(std::max(m_first_slice - slice_id, m_lines.size()), m_first_slice);
+            m_lines.insert(m_lines.begin(), grow, IntersectionLines());
+            m_first_slice -= grow;
+        }
+        if (slice_id - m_first_slice >= m_lines.size())
+            m_lines.resize(slice_id - m_first_slice + 1);
+        m_lines[slice_id - m_first_slice].emplace_back(il);
     }
 
-private:
-    struct CacheLineAlignedMutex
+    IntersectionLines *lines(size_t slice_id)
     {
-        alignas(hardware_destructive_interference_size) std::mutex mutex;
-    };
-    std::array<CacheLineAlignedMutex, 64> m_mutexes;
+        return slice_id >= m_first_slice && slice_id - m_first_slice < m_lines.size()
+                   ? &m_lines[slice_id - m_first_slice]
+                   : nullptr;
+    }
+
+private:
+    size_t m_first_slice{0};
+    std::vector<IntersectionLines> m_lines;
 };
 
+// Split the facets into ranges sliced into separate IntersectionLinesBins. A few ranges per thread
+// are enough to balance the load, while the number of bins to be merged per slice stays low.
+static inline size_t num_intersection_lines_bins(size_t num_facets)
+{
+    return std::clamp<size_t>(num_facets / 4096, 1, 4 * size_t(tbb::this_task_arena::max_concurrency()));
+}
+
+// Range of facets sliced into a bin of num_bins.
+static inline std::pair<size_t, size_t> intersection_lines_bin_facets(size_t num_facets, size_t num_bins,
+                                                                      size_t bin_idx)
+{
+    return {num_facets * bin_idx / num_bins, num_facets * (bin_idx + 1) / num_bins};
+}
+
+// Append the lines of the bins to the lines of the respective slices, in the order of the bins.
+// The bins are released.
+static void merge_intersection_lines_bins(std::vector<IntersectionLinesBin> &bins,
+                                          std::vector<IntersectionLines> &lines)
+{
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, lines.size()),
+                      [&bins, &lines](const tbb::blocked_range<size_t> &range)
+                      {
+                          for (size_t slice_id = range.begin(); slice_id < range.end(); ++slice_id)
+                          {
+                              IntersectionLines &out = lines[slice_id];
+                              size_t num_lines = out.size();
+                              for (IntersectionLinesBin &bin : bins)
+                                  if (const IntersectionLines *bin_lines = bin.lines(slice_id))
+                                      num_lines += bin_lines->size();
+                              out.reserve(num_lines);
+                              for (IntersectionLinesBin &bin : bins)
+                                  if (IntersectionLines *bin_lines = bin.lines(slice_id);
+                                      bin_lines && !bin_lines->empty())
+                                  {
+                                      if (out.empty())
+                                          out = std::move(*bin_lines);
+                                      else
+                                          append(out, std::move(*bin_lines));
+                                      *bin_lines = IntersectionLines();
+                                  }
+                          }
+                      });
+    bins.clear();
+}
+
 template<typename TransformVertex>
 void slice_facet_at_zs(
     // Scaled or unscaled vertices. transform_vertex_fn may scale zs.
     const std::vector<Vec3f> &mesh_vertices, const TransformVertex &transform_vertex_fn,
     const stl_triangle_vertex_indices &indices, const Vec3i &edge_ids, const ColorPolygon::Color facet_color,
     // Scaled or unscaled zs. If vertices have their zs scaled or transform_vertex_fn scales them, then zs have to be scaled as well.
-    const std::vector<float> &zs, std::vector<IntersectionLines> &lines, LinesMutexes &lines_mutex)
+    const std::vector<float> &zs, IntersectionLinesBin &lines)
 {
     stl_vertex vertices[3]{transform_vertex_fn(mesh_vertices[indices(0)]),
                            transform_vertex_fn(mesh_vertices[indices(1)]),
@@ -493,9 +547,7 @@ void slice_facet_at_zs(
                                           il) == FacetSliceType::Slicing)
         {
             assert(il.edge_type != IntersectionLine::FacetEdgeType::Horizontal);
-            size_t slice_id = it - zs.begin();
-            boost::lock_guard<std::mutex> l(lines_mutex(slice_id));
-            lines[slice_id].emplace_back(il);
+            lines.emplace_back(it - zs.begin(), il);
         }
     }
 }
@@ -510,20 +562,26 @@ static inline std::vector<IntersectionLines> slice_make_lines(const std::vector<
                                                               const ThrowOnCancel throw_on_cancel_fn)
 {
     std::vector<IntersectionLines> lines(zs.size(), IntersectionLines{});
-    LinesMutexes lines_mutex;
-    tbb::parallel_for(tbb::blocked_range<int>(0, int(indices.size())),
-                      [&vertices, &transform_vertex_fn, &indices, &face_edge_ids, &facet_color_fn, &zs, &lines,
-                       &lines_mutex, throw_on_cancel_fn](const tbb::blocked_range<int> &range)
+    std::vector<IntersectionLinesBin> bins(num_intersection_lines_bins(indices.size()));
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, bins.size(), 1),
+                      [&vertices, &transform_vertex_fn, &indices, &face_edge_ids, &facet_color_fn, &zs, &bins,
+                       throw_on_cancel_fn](const tbb::blocked_range<size_t> &range)
                       {
-                          for (int face_idx = range.begin(); face_idx < range.end(); ++face_idx)
+                          for (size_t bin_idx = range.begin(); bin_idx < range.end(); ++bin_idx)
                           {
-                              if ((face_idx & 0x0ffff) == 0)
-                                  throw_on_cancel_fn();
-                              slice_facet_at_zs(vertices, transform_vertex_fn, indices[face_idx],
-                                                face_edge_ids[face_idx], facet_color_fn(face_idx), zs, lines,
-                                                lines_mutex);
+                              auto [facet_begin, facet_end] = intersection_lines_bin_facets(indices.size(),
+                                                                                            bins.size(), bin_idx);
+                              for (size_t face_idx = facet_begin; face_idx < facet_end; ++face_idx)
+                              {
+                                  if ((face_idx & 0x0ffff) == 0)
+                                      throw_on_cancel_fn();
+                                  slice_facet_at_zs(vertices, transform_vertex_fn, indices[face_idx],
+                                                    face_edge_ids[face_idx], facet_color_fn(int(face_idx)), zs,
+                                                    bins[bin_idx]);
+                              }
                           }
                       });
+    merge_intersection_lines_bins(bins, lines);
 
     return lines;
 }
@@ -575,6 +633,13 @@ struct SlabLines
     std::vector<IntersectionLines> between_slices;
 };
 
+// SlabLines produced by slicing a range of facets, see IntersectionLinesBin.
+struct SlabLinesBin
+{
+    IntersectionLinesBin at_slice;
+    IntersectionLinesBin between_slices;
+};
+
 // Orientation of the face normal in regard to a XY plane pointing upwards.
 enum class FaceOrientation : char
 {
@@ -596,7 +661,7 @@ void slice_facet_with_slabs(
     const size_t facet_idx, const Vec3i &facet_neighbors, const Vec3i &facet_edge_ids,
     // Increase edge_ids at the top plane of the slab edges by num_edges to allow chaining
     // from bottom plane of the slab to the top plane of the slab and vice versa.
-    const int num_edges, const std::vector<float> &zs, SlabLines &lines, LinesMutexes &lines_mutex)
+    const int num_edges, const std::vector<float> &zs, SlabLinesBin &lines)
 {
     const stl_triangle_vertex_indices &indices = mesh_triangles[facet_idx];
     stl_vertex vertices[3]{mesh_vertices[indices(0)], mesh_vertices[indices(1)], mesh_vertices[indices(2)]};
@@ -612,12 +677,11 @@ void slice_facet_with_slabs(
     assert(min_layer == zs.end() ? max_layer == zs.end() : *min_layer >= min_z);
     assert(max_layer == zs.end() || *max_layer > max_z);
 
-    auto emit_slab_edge = [&lines, &lines_mutex](IntersectionLine il, size_t slab_id, bool reverse)
+    auto emit_slab_edge = [&lines](IntersectionLine il, size_t slab_id, bool reverse)
     {
         if (reverse)
             il.reverse();
-        boost::lock_guard<std::mutex> l(lines_mutex(slab_id));
-        lines.between_slices[slab_id].emplace_back(il);
+        lines.between_slices.emplace_back(slab_id, il);
     };
 
     if (min_layer == max_layer || horizontal)
@@ -640,8 +704,7 @@ void slice_facet_with_slabs(
 #else
             // Project the coplanar bottom facing triangles to the plane above the slicing plane to match the behavior of slice_mesh() / slice_mesh_ex(),
             // where the slicing plane slices the top facing surfaces, but misses the bottom facing surfaces.
-            if (size_t line_id = ProjectionFromTop ? slice_id : slice_id + 1;
-                ProjectionFromTop || line_id < lines.at_slice.size())
+            if (size_t line_id = ProjectionFromTop ? slice_id : slice_id + 1; ProjectionFromTop || line_id < zs.size())
 #endif
                 for (int iedge = 0; iedge < 3; ++iedge)
                     if (facet_neighbors(iedge) == -1)
@@ -661,8 +724,7 @@ void slice_facet_with_slabs(
                                                          : IntersectionLine::FacetEdgeType::Top;
                         // Don't flip the FacetEdgeType::Top edge, it will be flipped when chaining.
                         // if (! ProjectionFromTop) il.reverse();
-                        boost::lock_guard<std::mutex> l(lines_mutex(line_id));
-                        lines.at_slice[line_id].emplace_back(il);
+                        lines.at_slice.emplace_back(line_id, il);
                     }
         }
         else
@@ -814,9 +876,7 @@ void slice_facet_with_slabs(
                 {
                     if (!ProjectionFromTop)
                         il.reverse();
-                    size_t line_id = it - zs.begin();
-                    boost::lock_guard<std::mutex> l(lines_mutex(line_id));
-                    lines.at_slice[line_id].emplace_back(il);
+                    lines.at_slice.emplace_back(it - zs.begin(), il);
                 }
             }
             if (!ProjectionFromTop || it != zs.begin())
@@ -1001,8 +1061,6 @@ inline std::pair<SlabLines, SlabLines> slice_slabs_make_lines(
     std::pair<SlabLines, SlabLines> out;
     SlabLines &lines_top = out.first;
     SlabLines &lines_bottom = out.second;
-    LinesMutexes lines_mutex_top;
-    LinesMutexes lines_mutex_bottom;
 
     if (top)
     {
@@ -1015,47 +1073,74 @@ inline std::pair<SlabLines, SlabLines> slice_slabs_make_lines(
         lines_bottom.between_slices.assign(zs.size(), IntersectionLines());
     }
 
-    tbb::parallel_for(tbb::blocked_range<int>(0, int(indices.size())),
+    const size_t num_bins = num_intersection_lines_bins(indices.size());
+    std::vector<SlabLinesBin> bins_top(top ? num_bins : 0);
+    std::vector<SlabLinesBin> bins_bottom(bottom ? num_bins : 0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_bins, 1),
                       [&vertices, &indices, &face_neighbors, &face_edge_ids, num_edges, &face_orientation, &zs, top,
-                       bottom, &lines_top, &lines_bottom, &lines_mutex_top, &lines_mutex_bottom,
-                       throw_on_cancel_fn](const tbb::blocked_range<int> &range)
+                       bottom, num_bins, &bins_top, &bins_bottom,
+                       throw_on_cancel_fn](const tbb::blocked_range<size_t> &range)
                       {
-                          for (int face_idx = range.begin(); face_idx < range.end(); ++face_idx)
+                          for (size_t bin_idx = range.begin(); bin_idx < range.end(); ++bin_idx)
                           {
-                              if ((face_idx & 0x0ffff) == 0)
-                                  throw_on_cancel_fn();
-                              FaceOrientation fo = face_orientation[face_idx];
-                              Vec3i edge_ids = face_edge_ids[face_idx];
-                              if (top && (fo == FaceOrientation::Up || fo == FaceOrientation::Degenerate))
+                              auto [facet_begin, facet_end] = intersection_lines_bin_facets(indices.size(), num_bins,
+                                                                                            bin_idx);
+                              for (size_t face_idx = facet_begin; face_idx < facet_end; ++face_idx)
                               {
-                                  Vec3i neighbors = face_neighbors[face_idx];
-                                  // Reset neighborship of this triangle in case the other triangle is oriented backwards from this one.
-                                  for (int i = 0; i < 3; ++i)
-                                      if (neighbors(i) != -1)
-                                      {
-                                          FaceOrientation fo2 = face_orientation[neighbors(i)];
-                                          if (fo2 != FaceOrientation::Up && fo2 != FaceOrientation::Degenerate)
-                                              neighbors(i) = -1;
-                                      }
-                                  slice_facet_with_slabs<true>(vertices, indices, face_idx, neighbors, edge_ids,
-                                                               num_edges, zs, lines_top, lines_mutex_top);
-                              }
-                              if (bottom && (fo == FaceOrientation::Down || fo == FaceOrientation::Degenerate))
-                              {
-                                  Vec3i neighbors = face_neighbors[face_idx];
-                                  // Reset neighborship of this triangle in case the other triangle is oriented backwards from this one.
-                                  for (int i = 0; i < 3; ++i)
-                                      if (neighbors(i) != -1)
-                                      {
-                                          FaceOrientation fo2 = face_orientation[neighbors(i)];
-                                          if (fo2 != FaceOrientation::Down && fo2 != FaceOrientation::Degenerate)
-                                              neighbors(i) = -1;
-                                      }
-                                  slice_facet_with_slabs<false>(vertices, indices, face_idx, neighbors, edge_ids,
-                                                                num_edges, zs, lines_bottom, lines_mutex_bottom);
+                                  if ((face_idx & 0x0ffff) == 0)
+                                      throw_on_cancel_fn();
+                                  FaceOrientation fo = face_orientation[face_idx];
+                                  Vec3i edge_ids = face_edge_ids[face_idx];
+                                  if (top && (fo == FaceOrientation::Up || fo == FaceOrientation::Degenerate))
+                                  {
+                                      Vec3i neighbors = face_neighbors[face_idx];
+                                      // Reset neighborship of this triangle in case the other triangle is oriented backwards from this one.
+                                      for (int i = 0; i < 3; ++i)
+                                          if (neighbors(i) != -1)
+                                          {
+                                              FaceOrientation fo2 = face_orientation[neighbors(i)];
+                                              if (fo2 != FaceOrientation::Up && fo2 != FaceOrientation::Degenerate)
+                                                  neighbors(i) = -1;
+                                          }
+                                      slice_facet_with_slabs<true>(vertices, indices, face_idx, neighbors, edge_ids,
+                                                                   num_edges, zs, bins_top[bin_idx]);
+                                  }
+                                  if (bottom && (fo == FaceOrientation::Down || fo == FaceOrientation::Degenerate))
+                                  {
+                                      Vec3i neighbors = face_neighbors[face_idx];
+                                      // Reset neighborship of this triangle in case the other triangle is oriented backwards from this one.
+                                      for (int i = 0; i < 3; ++i)
+                                          if (neighbors(i) != -1)
+                                          {
+                                              FaceOrientation fo2 = face_orientation[neighbors(i)];
+                                              if (fo2 != FaceOrientation::Down && fo2 != FaceOrientation::Degenerate)
+                                                  neighbors(i) = -1;
+                                          }
+                                      slice_facet_with_slabs<false>(vertices, indices, face_idx, neighbors, edge_ids,
+                                                                    num_edges, zs, bins_bottom[bin_idx]);
+                                  }
                               }
                           }
                       });
+
+    auto merge = [](std::vector<SlabLinesBin> &bins, SlabLines &lines)
+    {
+        std::vector<IntersectionLinesBin> at_slice, between_slices;
+        at_slice.reserve(bins.size());
+        between_slices.reserve(bins.size());
+        for (SlabLinesBin &bin : bins)
+        {
+            at_slice.emplace_back(std::move(bin.at_slice));
+            between_slices.emplace_back(std::move(bin.between_slices));
+        }
+        bins.clear();
+        merge_intersection_lines_bins(at_slice, lines.at_slice);
+        merge_intersection_lines_bins(between_slices, lines.between_slices);
+    };
+    if (top)
+        merge(bins_top, lines_top);
+    if (bottom)
+        merge(bins_bottom, lines_bottom);
     return out;
 }
 
@@ -42,6 +42,11 @@ extern std::string log_memory_info(bool ignore_loglevel = false);
 extern void enforce_thread_count(std::size_t count);
 // Returns the size of physical memory (RAM) in bytes.
 extern size_t total_physical_memory();
+// Returns the peak resident memory of this process in bytes, zero if not available.
+extern size_t peak_memory_usage();
+// Returns the user + system CPU time consumed by this process, resp. by the calling thread, in seconds.
+extern double process_cpu_time();
+extern double thread_cpu_time();
 
 // Set a path with GUI resource files.
 void set_var_dir(const std::string &path);
@@ -1360,6 +1360,64 @@ std::string log_memory_info(bool ignore_loglevel)
     return out;
 }
 
+size_t peak_memory_usage()
+{
+#ifdef WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return size_t(pmc.PeakWorkingSetSize);
+    return 0;
+#else
+    rusage memory_info;
+    if (getrusage(RUSAGE_SELF, &memory_info) != 0)
+        return 0;
+    size_t peak_mem_usage = (size_t) memory_info.ru_maxrss;
+#ifdef __linux__
+    peak_mem_usage *= 1024; // getrusage returns the value in kB on linux
+#endif
+    return peak_mem_usage;
+#endif
+}
+
+#ifdef WIN32
+static double filetime_to_seconds(const FILETIME &ft)
+{
+    // FILETIME is in 100ns units.
+    return double((uint64_t(ft.dwHighDateTime) << 32) | ft.dwLowDateTime) * 1e-7;
+}
+#endif
+
+double process_cpu_time()
+{
+#ifdef WIN32
+    FILETIME creation, exit, kernel, user;
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return filetime_to_seconds(kernel) + filetime_to_seconds(user);
+    return 0.;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0.;
+    return double(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           double(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#endif
+}
+
+double thread_cpu_time()
+{
+#ifdef WIN32
+    FILETIME creation, exit, kernel, user;
+    if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+        return filetime_to_seconds(kernel) + filetime_to_seconds(user);
+    return 0.;
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+        return 0.;
+    return double(ts.tv_sec) + double(ts.tv_nsec) * 1e-9;
+#endif
+}
+
 // Returns the size of physical memory (RAM) in bytes.
 // http://nadeausoftware.com/articles/2012/09/c_c_tip_how_get_physical_memory_size_system
 size_t total_physical_memory()
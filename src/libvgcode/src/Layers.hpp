@@ -33,6 +33,8 @@ public:
     }
     float get_layer_z(std::size_t layer_id) const { return (layer_id < m_items.size()) ? m_items[layer_id].z : 0.0f; }
     std::size_t get_layer_id_at(float z) const;
+    // Range of the vertices of the given layer, the vertices are sorted by layers
+    const Interval &get_layer_vertices_range(std::size_t layer_id) const { return m_items[layer_id].range.get(); }
 
     const Interval &get_view_range() const { return m_view_range.get(); }
     void set_view_range(const Interval &range) { set_view_range(range[0], range[1]); }
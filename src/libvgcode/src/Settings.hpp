@@ -27,6 +27,8 @@ struct Settings
     //
     bool update_view_full_range{true};
     bool update_enabled_entities{true};
+    // the visibility of the moves changed, the lists of enabled entities are to be rebuilt
+    bool update_enabled_entities_lists{true};
     bool update_colors{true};
 
     //
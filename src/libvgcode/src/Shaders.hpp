@@ -33,6 +33,7 @@ static const char *Segments_Vertex_Shader =
     "uniform samplerBuffer height_width_angle_tex;\n"
     "uniform samplerBuffer color_tex;\n"
     "uniform usamplerBuffer segment_index_tex;\n"
+    "uniform int segment_index_offset;\n"
     "in int vertex_id;\n"
     "out vec3 color;\n"
     "out float clipping_dist;\n"
@@ -51,7 +52,7 @@ static const char *Segments_Vertex_Shader =
     "  return ambient + top_diffuse + front_diffuse + top_specular + emission;\n"
     "}\n"
     "void main() {\n"
-    "  int id_a = int(texelFetch(segment_index_tex, gl_InstanceID).r);\n"
+    "  int id_a = int(texelFetch(segment_index_tex, segment_index_offset + gl_InstanceID).r);\n"
     "  int id_b = id_a + 1;\n"
     "  vec3 pos_a = texelFetch(position_tex, id_a).xyz;\n"
     "  vec3 pos_b = texelFetch(position_tex, id_b).xyz;\n"
@@ -211,6 +212,7 @@ static const char *Options_Vertex_Shader =
     "uniform samplerBuffer height_width_angle_tex;\n"
     "uniform samplerBuffer color_tex;\n"
     "uniform usamplerBuffer segment_index_tex;\n"
+    "uniform int segment_index_offset;\n"
     "in vec3 in_position;\n"
     "in vec3 in_normal;\n"
     "out vec3 color;\n"
@@ -230,7 +232,7 @@ static const char *Options_Vertex_Shader =
     "  return ambient + top_diffuse + front_diffuse + top_specular + emission;\n"
     "}\n"
     "void main() {\n"
-    "  int id = int(texelFetch(segment_index_tex, gl_InstanceID).r);\n"
+    "  int id = int(texelFetch(segment_index_tex, segment_index_offset + gl_InstanceID).r);\n"
     "  vec2 height_width = texelFetch(height_width_angle_tex, id).xy;\n"
     "  vec3 offset = texelFetch(position_tex, id).xyz - vec3(0.0, 0.0, 0.5 * height_width.x);\n"
     "  height_width *= scaling_factor;\n"
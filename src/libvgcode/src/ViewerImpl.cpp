@@ -772,6 +772,11 @@ void ViewerImpl::init(const std::string &opengl_context_version)
            m_uni_segments_camera_position_id != -1 && m_uni_segments_positions_tex_id != -1 &&
            m_uni_segments_height_width_angle_tex_id != -1 && m_uni_segments_colors_tex_id != -1 &&
            m_uni_segments_segment_index_tex_id != -1 && m_uni_segments_clipping_plane_id != -1);
+#ifndef ENABLE_OPENGL_ES
+    m_uni_segments_segment_index_offset_id = glGetUniformLocation(m_segments_shader_id, "segment_index_offset");
+    glcheck();
+    assert(m_uni_segments_segment_index_offset_id != -1);
+#endif // ENABLE_OPENGL_ES
 
     m_segment_template.init();
 
@@ -794,6 +799,11 @@ void ViewerImpl::init(const std::string &opengl_context_version)
            m_uni_options_positions_tex_id != -1 && m_uni_options_height_width_angle_tex_id != -1 &&
            m_uni_options_colors_tex_id != -1 && m_uni_options_segment_index_tex_id != -1 &&
            m_uni_options_clipping_plane_id != -1);
+#ifndef ENABLE_OPENGL_ES
+    m_uni_options_segment_index_offset_id = glGetUniformLocation(m_options_shader_id, "segment_index_offset");
+    glcheck();
+    assert(m_uni_options_segment_index_offset_id != -1);
+#endif // ENABLE_OPENGL_ES
 
     m_option_template.init(16);
 
@@ -874,6 +884,9 @@ void ViewerImpl::reset()
     m_vertices.clear();
     m_vertices_colors.clear();
     m_valid_lines_bitset.clear();
+    m_enabled_segments_ids.clear();
+    m_enabled_options_ids.clear();
+    m_settings.update_enabled_entities_lists = true;
 #if VGCODE_ENABLE_COG_AND_TOOL_MARKERS
     m_cog_marker.reset();
 #endif // VGCODE_ENABLE_COG_AND_TOOL_MARKERS
@@ -881,7 +894,9 @@ void ViewerImpl::reset()
 #ifdef ENABLE_OPENGL_ES
     m_texture_data.reset();
 #else
+    m_enabled_segments_offset = 0;
     m_enabled_segments_count = 0;
+    m_enabled_options_offset = 0;
     m_enabled_options_count = 0;
 
     m_settings_used_for_ranges = std::nullopt;
@@ -905,9 +920,10 @@ void ViewerImpl::reset()
 // to position and heights_widths_angles vectors
 using Vec4 = std::array<float, 4>;
 
+// Writes one item per vertex into positions and / or heights_widths_angles, which may point into a mapped gpu buffer.
 static void extract_pos_and_or_hwa(const std::vector<PathVertex> &vertices, float travels_radius, float wipes_radius,
-                                   BitSet<> &valid_lines_bitset, std::vector<Vec4> *positions = nullptr,
-                                   std::vector<Vec4> *heights_widths_angles = nullptr, bool update_bitset = false)
+                                   BitSet<> &valid_lines_bitset, Vec4 *positions = nullptr,
+                                   Vec4 *heights_widths_angles = nullptr, bool update_bitset = false)
 {
     static constexpr const Vec3 ZERO = {0.0f, 0.0f, 0.0f};
     if (positions == nullptr && heights_widths_angles == nullptr)
@@ -917,10 +933,6 @@ static void extract_pos_and_or_hwa(const std::vector<PathVertex> &vertices, floa
     if (travels_radius <= 0.0f || wipes_radius <= 0.0f)
         return;
 
-    if (positions != nullptr)
-        positions->reserve(vertices.size());
-    if (heights_widths_angles != nullptr)
-        heights_widths_angles->reserve(vertices.size());
     for (size_t i = 0; i < vertices.size(); ++i)
     {
         const PathVertex &v = vertices[i];
@@ -949,7 +961,7 @@ static void extract_pos_and_or_hwa(const std::vector<PathVertex> &vertices, floa
             if (move_type == EMoveType::Extrude)
                 // push down extrusion vertices by half height to render them at the right z
                 position[2] -= 0.5f * v.height;
-            positions->emplace_back(position);
+            positions[i] = position;
         }
 
         if (heights_widths_angles != nullptr)
@@ -972,14 +984,37 @@ static void extract_pos_and_or_hwa(const std::vector<PathVertex> &vertices, floa
                 width = v.width;
             }
             // the last component is a dummy float to comply with GL_RGBA32F format
-            heights_widths_angles->push_back(
-                {height, width,
-                 std::atan2(prev_line[0] * this_line[1] - prev_line[1] * this_line[0], dot(prev_line, this_line)),
-                 0.0f});
+            heights_widths_angles[i] = {
+                height, width,
+                std::atan2(prev_line[0] * this_line[1] - prev_line[1] * this_line[0], dot(prev_line, this_line)),
+                0.0f};
         }
     }
 }
 
+#ifndef ENABLE_OPENGL_ES
+// Allocates the data store of the buffer bound to GL_TEXTURE_BUFFER for count items and lets fill() write them
+// straight into the mapped buffer, not staging them in a client side array to be copied by glBufferData().
+// If the buffer cannot be mapped or its content got lost while mapped, the items are uploaded from an array.
+template<class Fill> static void fill_texture_buffer(size_t count, GLenum usage, Fill &&fill)
+{
+    glsafe(glBufferData(GL_TEXTURE_BUFFER, count * sizeof(Vec4), nullptr, usage));
+    Vec4 *buffer = static_cast<Vec4 *>(glMapBuffer(GL_TEXTURE_BUFFER, GL_WRITE_ONLY));
+    glcheck();
+    if (buffer != nullptr)
+    {
+        fill(buffer);
+        const GLboolean unmapped = glUnmapBuffer(GL_TEXTURE_BUFFER);
+        glcheck();
+        if (unmapped == GL_TRUE)
+            return;
+    }
+    std::vector<Vec4> data(count);
+    fill(data.data());
+    glsafe(glBufferSubData(GL_TEXTURE_BUFFER, 0, count * sizeof(Vec4), data.data()));
+}
+#endif // ENABLE_OPENGL_ES
+
 void ViewerImpl::load(GCodeInputData &&gcode_data)
 {
     if (!m_initialized)
@@ -1072,26 +1107,23 @@ void ViewerImpl::load(GCodeInputData &&gcode_data)
         progress_callback(0.4f); // Vertex processing complete (40%)
     }
 
-    // buffers to send to gpu
-    // the last component is a dummy float to comply with GL_RGBA32F format
-    std::vector<Vec4> positions;
-    std::vector<Vec4> heights_widths_angles;
-    positions.reserve(m_vertices.size());
-    heights_widths_angles.reserve(m_vertices.size());
-    extract_pos_and_or_hwa(m_vertices, m_travels_radius, m_wipes_radius, m_valid_lines_bitset, &positions,
-                           &heights_widths_angles, true);
-
-    if (!positions.empty())
+    if (m_travels_radius > 0.0f && m_wipes_radius > 0.0f)
     {
 #ifdef ENABLE_OPENGL_ES
+        // buffers to send to gpu
+        // the last component is a dummy float to comply with GL_RGBA32F format
+        std::vector<Vec4> positions(m_vertices.size());
+        std::vector<Vec4> heights_widths_angles(m_vertices.size());
+        extract_pos_and_or_hwa(m_vertices, m_travels_radius, m_wipes_radius, m_valid_lines_bitset, positions.data(),
+                               heights_widths_angles.data(), true);
         m_texture_data.init(positions.size());
         // create and fill position textures
         m_texture_data.set_positions(positions);
         // create and fill height, width and angle textures
         m_texture_data.set_heights_widths_angles(heights_widths_angles);
 #else
-        m_positions_tex_size = positions.size() * sizeof(Vec3);
-        m_height_width_angle_tex_size = heights_widths_angles.size() * sizeof(Vec3);
+        m_positions_tex_size = m_vertices.size() * sizeof(Vec3);
+        m_height_width_angle_tex_size = m_vertices.size() * sizeof(Vec3);
 
         int old_bound_texture = 0;
         glsafe(glGetIntegerv(GL_TEXTURE_BINDING_BUFFER, &old_bound_texture));
@@ -1101,9 +1133,15 @@ void ViewerImpl::load(GCodeInputData &&gcode_data)
             progress_callback(0.50f);
         }
         // create and fill positions buffer (HEAVY BLOCKING OPERATION)
+        // the positions pass resets the invalid lines in m_valid_lines_bitset, the angles pass below reads them
         glsafe(glGenBuffers(1, &m_positions_buf_id));
         glsafe(glBindBuffer(GL_TEXTURE_BUFFER, m_positions_buf_id));
-        glsafe(glBufferData(GL_TEXTURE_BUFFER, positions.size() * sizeof(Vec4), positions.data(), GL_STATIC_DRAW));
+        fill_texture_buffer(m_vertices.size(), GL_STATIC_DRAW,
+                            [this](Vec4 *positions)
+                            {
+                                extract_pos_and_or_hwa(m_vertices, m_travels_radius, m_wipes_radius,
+                                                       m_valid_lines_bitset, positions, nullptr, true);
+                            });
         glsafe(glGenTextures(1, &m_positions_tex_id));
         glsafe(glBindTexture(GL_TEXTURE_BUFFER, m_positions_tex_id));
 
@@ -1114,8 +1152,12 @@ void ViewerImpl::load(GCodeInputData &&gcode_data)
         // create and fill height, width and angles buffer (HEAVY BLOCKING OPERATION)
         glsafe(glGenBuffers(1, &m_heights_widths_angles_buf_id));
         glsafe(glBindBuffer(GL_TEXTURE_BUFFER, m_heights_widths_angles_buf_id));
-        glsafe(glBufferData(GL_TEXTURE_BUFFER, heights_widths_angles.size() * sizeof(Vec4),
-                            heights_widths_angles.data(), GL_DYNAMIC_DRAW));
+        fill_texture_buffer(m_vertices.size(), GL_DYNAMIC_DRAW,
+                            [this](Vec4 *heights_widths_angles)
+                            {
+                                extract_pos_and_or_hwa(m_vertices, m_travels_radius, m_wipes_radius,
+                                                       m_valid_lines_bitset, nullptr, heights_widths_angles);
+                            });
         glsafe(glGenTextures(1, &m_heights_widths_angles_tex_id));
         glsafe(glBindTexture(GL_TEXTURE_BUFFER, m_heights_widths_angles_tex_id));
 
@@ -1166,8 +1208,9 @@ void ViewerImpl::update_enabled_entities()
     if (m_vertices.empty())
         return;
 
-    std::vector<uint32_t> enabled_segments;
-    std::vector<uint32_t> enabled_options;
+    if (m_settings.update_enabled_entities_lists)
+        update_enabled_entities_lists();
+
     Interval range = m_view_range.get_visible();
 
     // when top layer only visualization is enabled, we need to render
@@ -1188,7 +1231,39 @@ void ViewerImpl::update_enabled_entities()
             --range[0];
     }
 
-    for (size_t i = range[0]; i < range[1]; ++i)
+    // the entities enabled in [range[0], range[1]) are a slice of the sorted lists of all the enabled entities,
+    // thus moving the view range does not touch the other entities
+    auto slice = [&range](const std::vector<uint32_t> &ids)
+    {
+        const auto first_it = std::lower_bound(ids.begin(), ids.end(), range[0]);
+        const auto last_it = std::lower_bound(first_it, ids.end(), range[1]);
+        return std::make_pair(static_cast<size_t>(std::distance(ids.begin(), first_it)),
+                              static_cast<size_t>(std::distance(first_it, last_it)));
+    };
+
+#ifdef ENABLE_OPENGL_ES
+    const auto [segments_offset, segments_count] = slice(m_enabled_segments_ids);
+    const auto [options_offset, options_count] = slice(m_enabled_options_ids);
+    m_texture_data.set_enabled_segments(
+        std::vector<uint32_t>(m_enabled_segments_ids.begin() + segments_offset,
+                              m_enabled_segments_ids.begin() + segments_offset + segments_count));
+    m_texture_data.set_enabled_options(
+        std::vector<uint32_t>(m_enabled_options_ids.begin() + options_offset,
+                              m_enabled_options_ids.begin() + options_offset + options_count));
+#else
+    std::tie(m_enabled_segments_offset, m_enabled_segments_count) = slice(m_enabled_segments_ids);
+    std::tie(m_enabled_options_offset, m_enabled_options_count) = slice(m_enabled_options_ids);
+#endif // ENABLE_OPENGL_ES
+
+    m_settings.update_enabled_entities = false;
+}
+
+void ViewerImpl::update_enabled_entities_lists()
+{
+    m_enabled_segments_ids.clear();
+    m_enabled_options_ids.clear();
+
+    for (size_t i = 0; i < m_vertices.size(); ++i)
     {
         const PathVertex &v = m_vertices[i];
 
@@ -1218,43 +1293,37 @@ void ViewerImpl::update_enabled_entities()
             continue;
 
         if (v.is_option())
-            enabled_options.push_back(static_cast<uint32_t>(i));
+            m_enabled_options_ids.push_back(static_cast<uint32_t>(i));
         else
-            enabled_segments.push_back(static_cast<uint32_t>(i));
+            m_enabled_segments_ids.push_back(static_cast<uint32_t>(i));
     }
 
-#ifdef ENABLE_OPENGL_ES
-    m_texture_data.set_enabled_segments(enabled_segments);
-    m_texture_data.set_enabled_options(enabled_options);
-#else
-    m_enabled_segments_count = enabled_segments.size();
-    m_enabled_options_count = enabled_options.size();
-
-    m_enabled_segments_tex_size = enabled_segments.size() * sizeof(uint32_t);
-    m_enabled_options_tex_size = enabled_options.size() * sizeof(uint32_t);
+#ifndef ENABLE_OPENGL_ES
+    m_enabled_segments_tex_size = m_enabled_segments_ids.size() * sizeof(uint32_t);
+    m_enabled_options_tex_size = m_enabled_options_ids.size() * sizeof(uint32_t);
 
     // update gpu buffer for enabled segments
     assert(m_enabled_segments_buf_id > 0);
     glsafe(glBindBuffer(GL_TEXTURE_BUFFER, m_enabled_segments_buf_id));
-    if (!enabled_segments.empty())
-        glsafe(glBufferData(GL_TEXTURE_BUFFER, enabled_segments.size() * sizeof(uint32_t), enabled_segments.data(),
-                            GL_STATIC_DRAW));
+    if (!m_enabled_segments_ids.empty())
+        glsafe(glBufferData(GL_TEXTURE_BUFFER, m_enabled_segments_ids.size() * sizeof(uint32_t),
+                            m_enabled_segments_ids.data(), GL_STATIC_DRAW));
     else
         glsafe(glBufferData(GL_TEXTURE_BUFFER, 0, nullptr, GL_STATIC_DRAW));
 
     // update gpu buffer for enabled options
     assert(m_enabled_options_buf_id > 0);
     glsafe(glBindBuffer(GL_TEXTURE_BUFFER, m_enabled_options_buf_id));
-    if (!enabled_options.empty())
-        glsafe(glBufferData(GL_TEXTURE_BUFFER, enabled_options.size() * sizeof(uint32_t), enabled_options.data(),
-                            GL_STATIC_DRAW));
+    if (!m_enabled_options_ids.empty())
+        glsafe(glBufferData(GL_TEXTURE_BUFFER, m_enabled_options_ids.size() * sizeof(uint32_t),
+                            m_enabled_options_ids.data(), GL_STATIC_DRAW));
     else
         glsafe(glBufferData(GL_TEXTURE_BUFFER, 0, nullptr, GL_STATIC_DRAW));
 
     glsafe(glBindBuffer(GL_TEXTURE_BUFFER, 0));
 #endif // ENABLE_OPENGL_ES
 
-    m_settings.update_enabled_entities = false;
+    m_settings.update_enabled_entities_lists = false;
 }
 
 static float encode_color(const Color &color)
@@ -1286,6 +1355,7 @@ void ViewerImpl::update_colors_texture()
     // colors[i] = (color_top_layer_only && m_vertices[i].layer_id < top_layer_id &&
     //             (!m_settings.spiral_vase_mode || i != m_view_range.get_enabled()[0])) ?
     //             encode_color(DUMMY_COLOR) : m_vertices_colors[i];
+    // As the colors do not depend on the view range, the texture is not updated when the view range changes.
 
 #ifdef ENABLE_OPENGL_ES
     if (!colors.empty())
@@ -1376,7 +1446,6 @@ void ViewerImpl::set_layers_view_range(Interval::value_type min, Interval::value
     m_view_range.set_visible(m_view_range.get_enabled());
     m_settings.update_enabled_entities = true;
     //m_settings.update_colors = true;
-    update_colors_texture();
 }
 
 void ViewerImpl::toggle_top_layer_only_view_range()
@@ -1386,7 +1455,6 @@ void ViewerImpl::toggle_top_layer_only_view_range()
     m_view_range.set_visible(m_view_range.get_enabled());
     m_settings.update_enabled_entities = true;
     //m_settings.update_colors = true;
-    update_colors_texture();
 }
 
 std::vector<ETimeMode> ViewerImpl::get_time_modes() const
@@ -1479,6 +1547,7 @@ void ViewerImpl::toggle_option_visibility(EOptionType type)
         else if (m_settings.top_layer_only_view_range && new_enabled_range[0] < visible_range[0])
             m_view_range.set_visible(new_enabled_range[0], visible_range[1]);
     }
+    m_settings.update_enabled_entities_lists = true;
     m_settings.update_enabled_entities = true;
     m_settings.update_colors = true;
 }
@@ -1492,6 +1561,7 @@ void ViewerImpl::toggle_extrusion_role_visibility(EGCodeExtrusionRole role)
 {
     m_settings.extrusion_roles_visibility[size_t(role)] = !m_settings.extrusion_roles_visibility[size_t(role)];
     update_view_full_range();
+    m_settings.update_enabled_entities_lists = true;
     m_settings.update_enabled_entities = true;
     m_settings.update_colors = true;
 }
@@ -1504,7 +1574,6 @@ void ViewerImpl::set_view_visible_range(Interval::value_type min, Interval::valu
     m_view_range.set_visible(min, max);
     update_enabled_entities();
     //m_settings.update_colors = true;
-    update_colors_texture();
 }
 
 float ViewerImpl::get_estimated_time_at(size_t id) const
@@ -1775,6 +1844,8 @@ size_t ViewerImpl::get_used_cpu_memory() const
     ret += sizeof(m_options_colors);
     ret += STDVEC_MEMSIZE(m_vertices, PathVertex);
     ret += m_valid_lines_bitset.size_in_bytes_cpu();
+    ret += STDVEC_MEMSIZE(m_enabled_segments_ids, uint32_t);
+    ret += STDVEC_MEMSIZE(m_enabled_options_ids, uint32_t);
     ret += m_height_range.size_in_bytes_cpu();
     ret += m_width_range.size_in_bytes_cpu();
     ret += m_speed_range.size_in_bytes_cpu();
@@ -1834,7 +1905,11 @@ void ViewerImpl::update_view_full_range()
     const bool travels_visible = m_settings.options_visibility[size_t(EOptionType::Travels)];
     const bool wipes_visible = m_settings.options_visibility[size_t(EOptionType::Wipes)];
 
+    // the vertices are sorted by layers, start the searches at the boundaries of the layers range
+    // to not walk through all the vertices below it
     auto first_it = m_vertices.begin();
+    if (layers_range[0] < m_layers.count())
+        first_it += m_layers.get_layer_vertices_range(layers_range[0])[0];
     while (first_it != m_vertices.end() && (first_it->layer_id < layers_range[0] || !is_visible(*first_it, m_settings)))
     {
         ++first_it;
@@ -1859,6 +1934,8 @@ void ViewerImpl::update_view_full_range()
         }
 
         auto last_it = first_it;
+        if (layers_range[1] < m_layers.count())
+            last_it = std::max(last_it, m_vertices.begin() + m_layers.get_layer_vertices_range(layers_range[1])[1]);
         while (last_it != m_vertices.end() && last_it->layer_id <= layers_range[1])
         {
             ++last_it;
@@ -1904,15 +1981,17 @@ void ViewerImpl::update_view_full_range()
         if (m_settings.top_layer_only_view_range)
         {
             const Interval &full_range = m_view_range.get_full();
-            auto top_first_it = m_vertices.begin() + full_range[0];
-            bool shortened = false;
+            const auto full_first_it = m_vertices.begin() + full_range[0];
+            auto top_first_it = full_first_it;
+            if (layers_range[1] < m_layers.count())
+                top_first_it = std::max(top_first_it, m_vertices.begin() +
+                                                          m_layers.get_layer_vertices_range(layers_range[1])[0]);
             while (top_first_it != m_vertices.end() &&
                    (top_first_it->layer_id < layers_range[1] || !is_visible(*top_first_it, m_settings)))
             {
                 ++top_first_it;
-                shortened = true;
             }
-            if (shortened)
+            if (top_first_it != full_first_it)
                 --top_first_it;
 
             // when spiral vase mode is enabled and only one layer is shown, extend the range by one step
@@ -1985,10 +2064,9 @@ void ViewerImpl::update_color_ranges()
 void ViewerImpl::update_heights_widths()
 {
 #ifdef ENABLE_OPENGL_ES
-    std::vector<Vec3> heights_widths_angles;
-    heights_widths_angles.reserve(m_vertices.size());
+    std::vector<Vec4> heights_widths_angles(m_vertices.size());
     extract_pos_and_or_hwa(m_vertices, m_travels_radius, m_wipes_radius, m_valid_lines_bitset, nullptr,
-                           &heights_widths_angles);
+                           heights_widths_angles.data());
     m_texture_data.set_heights_widths_angles(heights_widths_angles);
 #else
     if (m_heights_widths_angles_buf_id == 0)
@@ -1996,7 +2074,7 @@ void ViewerImpl::update_heights_widths()
 
     glsafe(glBindBuffer(GL_TEXTURE_BUFFER, m_heights_widths_angles_buf_id));
 
-    Vec3 *buffer = static_cast<Vec3 *>(glMapBuffer(GL_TEXTURE_BUFFER, GL_WRITE_ONLY));
+    Vec4 *buffer = static_cast<Vec4 *>(glMapBuffer(GL_TEXTURE_BUFFER, GL_WRITE_ONLY));
     glcheck();
 
     for (size_t i = 0; i < m_vertices.size(); ++i)
@@ -2092,6 +2170,7 @@ void ViewerImpl::render_segments(const Mat4x4 &view_matrix, const Mat4x4 &projec
     glsafe(glActiveTexture(GL_TEXTURE3));
     glsafe(glBindTexture(GL_TEXTURE_BUFFER, m_enabled_segments_tex_id));
     glsafe(glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, m_enabled_segments_buf_id));
+    glsafe(glUniform1i(m_uni_segments_segment_index_offset_id, static_cast<int>(m_enabled_segments_offset)));
 
     m_segment_template.render(m_enabled_segments_count);
 #endif // ENABLE_OPENGL_ES
@@ -2183,6 +2262,7 @@ void ViewerImpl::render_options(const Mat4x4 &view_matrix, const Mat4x4 &project
     glsafe(glActiveTexture(GL_TEXTURE3));
     glsafe(glBindTexture(GL_TEXTURE_BUFFER, m_enabled_options_tex_id));
     glsafe(glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, m_enabled_options_buf_id));
+    glsafe(glUniform1i(m_uni_options_segment_index_offset_id, static_cast<int>(m_enabled_options_offset)));
 
     m_option_template.render(m_enabled_options_count);
 #endif // ENABLE_OPENGL_ES
@@ -60,7 +60,7 @@ public:
 
     //
     // Update the visibility property of toolpaths in dependence
-    // of the current settings
+    // of the current settings and view range
     //
     void update_enabled_entities();
     //
@@ -294,6 +294,12 @@ private:
     //
     BitSet<> m_valid_lines_bitset;
     //
+    // Sorted ids of all the enabled segments / options regardless of the view range.
+    // The entities enabled in the view range are a slice of them.
+    //
+    std::vector<uint32_t> m_enabled_segments_ids;
+    std::vector<uint32_t> m_enabled_options_ids;
+    //
     // Variables used for toolpaths coloring
     //
     std::optional<Settings> m_settings_used_for_ranges;
@@ -328,6 +334,7 @@ private:
     int m_uni_segments_height_width_angle_tex_id{-1};
     int m_uni_segments_colors_tex_id{-1};
     int m_uni_segments_segment_index_tex_id{-1};
+    int m_uni_segments_segment_index_offset_id{-1};
     int m_uni_segments_clipping_plane_id{-1};
     //
     // Caches for OpenGL uniforms id for options shader
@@ -338,6 +345,7 @@ private:
     int m_uni_options_height_width_angle_tex_id{-1};
     int m_uni_options_colors_tex_id{-1};
     int m_uni_options_segment_index_tex_id{-1};
+    int m_uni_options_segment_index_offset_id{-1};
     int m_uni_options_clipping_plane_id{-1};
 #if VGCODE_ENABLE_COG_AND_TOOL_MARKERS
     //
@@ -452,12 +460,16 @@ private:
     //
     unsigned int m_enabled_segments_buf_id{0};
     unsigned int m_enabled_segments_tex_id{0};
+    // slice of the buffer enabled in the view range
+    size_t m_enabled_segments_offset{0};
     size_t m_enabled_segments_count{0};
     //
     // OpenGL buffers to store enabled options
     //
     unsigned int m_enabled_options_buf_id{0};
     unsigned int m_enabled_options_tex_id{0};
+    // slice of the buffer enabled in the view range
+    size_t m_enabled_options_offset{0};
     size_t m_enabled_options_count{0};
     //
     // Caches for size of data sent to gpu, in bytes
@@ -470,6 +482,7 @@ private:
 #endif // ENABLE_OPENGL_ES
 
     void update_view_full_range();
+    void update_enabled_entities_lists();
     void update_color_ranges();
     void update_heights_widths();
     void render_segments(const Mat4x4 &view_matrix, const Mat4x4 &projection_matrix, const Vec3 &camera_position);
@@ -12,9 +12,11 @@
 #include <stddef.h>
 #include <optional>
 #include <algorithm>
+#include <atomic>
 #include <initializer_list>
 #include <memory>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -22,6 +24,7 @@
 #include <cstddef>
 
 #include <libslic3r/ExPolygon.hpp>
+#include <libslic3r/Execution/ExecutionTBB.hpp>
 #include <libslic3r/BoundingBox.hpp>
 #include <libslic3r/AnyPtr.hpp>
 #include <libslic3r/Point.hpp>
@@ -278,34 +281,43 @@ template<class FixedIt, class StopCond = DefaultStopCondition>
 static Polygons calculate_nfp_unnormalized(const ArrangeItem &item, const Range<FixedIt> &fixed_items,
                                            StopCond &&stop_cond = {})
 {
-    size_t cap = 0;
-
-    for (const ArrangeItem &fixitem : fixed_items)
-    {
-        const Polygons &outlines = fixitem.shape().transformed_outline();
-        cap += outlines.size();
-    }
+    // fixed_polys should already be a set of strictly convex polygons,
+    // as ArrangeItem stores convex-decomposed polygons.
+    // The shapes cache their transformed outlines and reference vertices lazily, thus the caches are filled in
+    // here, before the shapes are shared by the worker threads.
+    std::vector<const Polygon *> fixed_polys;
+    for (const ArrangeItem &fixed : fixed_items)
+        for (const Polygon &fixed_poly : fixed.shape().transformed_outline())
+            fixed_polys.emplace_back(&fixed_poly);
 
     const Polygons &item_outlines = item.envelope().transformed_outline();
-
-    auto nfps = reserve_polygons(cap * item_outlines.size());
-
     Vec2crd ref_whole = item.envelope().reference_vertex();
-    Polygon subnfp;
-
-    for (const ArrangeItem &fixed : fixed_items)
-    {
-        // fixed_polys should already be a set of strictly convex polygons,
-        // as ArrangeItem stores convex-decomposed polygons
-        const Polygons &fixed_polys = fixed.shape().transformed_outline();
 
-        for (const Polygon &fixed_poly : fixed_polys)
+    // Each pair of a fixed and a movable convex polygon writes its sub NFP into its own slot and the sub NFPs are
+    // united at once, thus the result does not depend on the number of threads.
+    // The stop condition is polled by the calling thread only, which takes part in the loop, the worker threads
+    // just skip the remaining pairs once it has been met.
+    Polygons nfps(fixed_polys.size() * item_outlines.size());
+    const std::thread::id calling_thread = std::this_thread::get_id();
+    std::atomic<bool> stopped{false};
+    execution::for_each(
+        ex_tbb, size_t(0), fixed_polys.size(),
+        [&](size_t fixed_idx)
         {
+            if (stopped.load(std::memory_order_relaxed))
+                return;
+            if (std::this_thread::get_id() == calling_thread && stop_cond())
+            {
+                stopped.store(true, std::memory_order_relaxed);
+                return;
+            }
+            const Polygon &fixed_poly = *fixed_polys[fixed_idx];
             Point max_fixed = Slic3r::reference_vertex(fixed_poly);
             for (size_t mi = 0; mi < item_outlines.size(); ++mi)
             {
                 const Polygon &movable = item_outlines[mi];
                 const Vec2crd &mref = item.envelope().reference_vertex(mi);
+                Polygon &subnfp = nfps[fixed_idx * item_outlines.size() + mi];
                 subnfp = nfp_convex_convex_legacy(fixed_poly, movable);
 
                 Vec2crd min_movable = item.envelope().min_vertex(mi);
@@ -317,23 +329,14 @@ static Polygons calculate_nfp_unnormalized(const ArrangeItem &item, const Range<
 
                 auto d = ref_whole - mref + dnfp;
                 subnfp.translate(d);
-                nfps.emplace_back(subnfp);
             }
+        },
+        16);
 
-            if (stop_cond())
-                break;
-
-            nfps = union_(nfps);
-        }
-
-        if (stop_cond())
-        {
-            nfps.clear();
-            break;
-        }
-    }
+    if (stopped || stop_cond())
+        return {};
 
-    return nfps;
+    return union_(nfps);
 }
 
 template<>
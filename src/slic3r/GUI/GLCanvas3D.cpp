@@ -8320,6 +8320,35 @@ void GLCanvas3D::show_binary_gcode_debug_window()
                         175.0f))
             binarizer_config.gcode_encoding = (EGCodeEncodingType) option_id;
 
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        ImGuiPureWrap::text_colored(ImGuiPureWrap::COL_ORANGE_LIGHT, "GCode block size");
+        ImGui::TableSetColumnIndex(1);
+        options = {"16 kB", "32 kB", "64 kB", "128 kB", "256 kB"};
+        option_id = 0;
+        while (option_id + 1 < (int) options.size() && (size_t(16384) << option_id) < binarizer_config.gcode_block_size)
+            ++option_id;
+        if (imgui.combo(std::string("##gcode_block_size"), options, option_id, ImGuiComboFlags_HeightLargest, 0.0f,
+                        175.0f))
+            binarizer_config.gcode_block_size = size_t(16384) << option_id;
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        ImGuiPureWrap::text_colored(ImGuiPureWrap::COL_ORANGE_LIGHT, "GCode compression threads");
+        ImGui::TableSetColumnIndex(1);
+        options = {"Auto", "1", "2", "4", "8", "16"};
+        option_id = 0;
+        if (binarizer_config.gcode_compression_threads > 0)
+        {
+            option_id = 1;
+            while (option_id + 1 < (int) options.size() &&
+                   (size_t(1) << (option_id - 1)) < binarizer_config.gcode_compression_threads)
+                ++option_id;
+        }
+        if (imgui.combo(std::string("##gcode_compression_threads"), options, option_id, ImGuiComboFlags_HeightLargest,
+                        0.0f, 175.0f))
+            binarizer_config.gcode_compression_threads = option_id == 0 ? 0 : size_t(1) << (option_id - 1);
+
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         ImGuiPureWrap::text_colored(ImGuiPureWrap::COL_ORANGE_LIGHT, "Metadata encoding");
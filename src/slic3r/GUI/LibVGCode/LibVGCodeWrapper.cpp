@@ -398,8 +398,39 @@ GCodeInputData convert(const Slic3r::GCodeProcessorResult &result, const std::ve
         ret.color_print_colors.emplace_back(convert(color));
     }
 
-    const std::vector<Slic3r::GCodeProcessorResult::MoveVertex> &moves = result.moves;
-    ret.vertices.reserve(2 * moves.size());
+    const Slic3r::GCodeProcessorResult::MoveVertices &moves = result.moves;
+    const std::vector<Slic3r::EMoveType> &types = moves.types();
+    const std::vector<Slic3r::GCodeExtrusionRole> &extrusion_roles = moves.extrusion_roles();
+    const std::vector<float> &widths = moves.widths();
+    const std::vector<float> &heights = moves.heights();
+    // Whether a 'phantom' vertex is to be added in front of the vertex of the move i, see below.
+    auto starts_path = [&](size_t i)
+    {
+        const EOptionType option_type = move_type_to_option(convert(types[i]));
+        if (option_type != EOptionType::COUNT && option_type != EOptionType::Travels &&
+            option_type != EOptionType::Wipes)
+            return false;
+        // When width or height changes significantly (>5%), insert a path break to prevent
+        // the tapering effect in the preview. This is needed for interlocking perimeters
+        // which have abrupt width changes when transitioning flow rates.
+        const float width_change_threshold = 0.05f; // 5% change triggers break
+        const bool significant_width_change = (widths[i - 1] > 0.0f && widths[i] > 0.0f) &&
+                                              std::abs(widths[i] - widths[i - 1]) / widths[i - 1] >
+                                                  width_change_threshold;
+        const bool significant_height_change = (heights[i - 1] > 0.0f && heights[i] > 0.0f) &&
+                                               std::abs(heights[i] - heights[i - 1]) / heights[i - 1] >
+                                                   width_change_threshold;
+        return i == 1 || types[i - 1] != types[i] || extrusion_roles[i - 1] != extrusion_roles[i] ||
+               significant_width_change || significant_height_change;
+    };
+
+    // Count the vertices to allocate them exactly, the viewer takes over the vector as it is.
+    // Just the columns tested by starts_path() are read.
+    size_t vertices_count = 0;
+    for (size_t i = 1; i < moves.size(); ++i)
+        vertices_count += starts_path(i) ? 2 : 1;
+    ret.vertices.reserve(vertices_count);
+
     const size_t total_moves = moves.size();
     for (size_t i = 1; i < moves.size(); ++i)
     {
@@ -409,65 +440,49 @@ GCodeInputData convert(const Slic3r::GCodeProcessorResult &result, const std::ve
             float progress = (float) i / (float) total_moves;
             progress_callback(progress);
         }
-        const Slic3r::GCodeProcessorResult::MoveVertex &curr = moves[i];
-        const Slic3r::GCodeProcessorResult::MoveVertex &prev = moves[i - 1];
+        const Slic3r::GCodeProcessorResult::MoveVertices::ConstRef curr = moves[i];
+        const Slic3r::GCodeProcessorResult::MoveVertices::ConstRef prev = moves[i - 1];
         const EMoveType curr_type = convert(curr.type);
-        const EOptionType option_type = move_type_to_option(curr_type);
-        if (option_type == EOptionType::COUNT || option_type == EOptionType::Travels ||
-            option_type == EOptionType::Wipes)
+        if (starts_path(i))
         {
-            // When width or height changes significantly (>5%), insert a path break to prevent
-            // the tapering effect in the preview. This is needed for interlocking perimeters
-            // which have abrupt width changes when transitioning flow rates.
-            const float width_change_threshold = 0.05f; // 5% change triggers break
-            const bool significant_width_change = (prev.width > 0.0f && curr.width > 0.0f) &&
-                                                  std::abs(curr.width - prev.width) / prev.width >
-                                                      width_change_threshold;
-            const bool significant_height_change = (prev.height > 0.0f && curr.height > 0.0f) &&
-                                                   std::abs(curr.height - prev.height) / prev.height >
-                                                       width_change_threshold;
-            if (ret.vertices.empty() || prev.type != curr.type || prev.extrusion_role != curr.extrusion_role ||
-                significant_width_change || significant_height_change)
-            {
-                // to allow libvgcode to properly detect the start/end of a path we need to add a 'phantom' vertex
-                // equal to the current one with the exception of the position, which should match the previous move position,
-                // and the times, which are set to zero
+            // to allow libvgcode to properly detect the start/end of a path we need to add a 'phantom' vertex
+            // equal to the current one with the exception of the position, which should match the previous move position,
+            // and the times, which are set to zero
 #if VGCODE_ENABLE_COG_AND_TOOL_MARKERS
-                const libvgcode::PathVertex vertex = {convert(prev.position),
-                                                      curr.height,
-                                                      curr.width,
-                                                      curr.feedrate,
-                                                      prev.actual_feedrate,
-                                                      curr.mm3_per_mm,
-                                                      curr.fan_speed,
-                                                      curr.temperature,
-                                                      0.0f,
-                                                      convert(curr.extrusion_role),
-                                                      curr_type,
-                                                      static_cast<uint32_t>(curr.gcode_id),
-                                                      static_cast<uint32_t>(curr.layer_id),
-                                                      static_cast<uint8_t>(curr.extruder_id),
-                                                      static_cast<uint8_t>(curr.cp_color_id),
-                                                      {0.0f, 0.0f}};
+            const libvgcode::PathVertex vertex = {convert(prev.position),
+                                                  curr.height,
+                                                  curr.width,
+                                                  curr.feedrate,
+                                                  prev.actual_feedrate,
+                                                  curr.mm3_per_mm,
+                                                  curr.fan_speed,
+                                                  curr.temperature,
+                                                  0.0f,
+                                                  convert(curr.extrusion_role),
+                                                  curr_type,
+                                                  static_cast<uint32_t>(curr.gcode_id),
+                                                  static_cast<uint32_t>(curr.layer_id),
+                                                  static_cast<uint8_t>(curr.extruder_id),
+                                                  static_cast<uint8_t>(curr.cp_color_id),
+                                                  {0.0f, 0.0f}};
 #else
-                const libvgcode::PathVertex vertex = {convert(prev.position),
-                                                      curr.height,
-                                                      curr.width,
-                                                      curr.feedrate,
-                                                      prev.actual_feedrate,
-                                                      curr.mm3_per_mm,
-                                                      curr.fan_speed,
-                                                      curr.temperature,
-                                                      convert(curr.extrusion_role),
-                                                      curr_type,
-                                                      static_cast<uint32_t>(curr.gcode_id),
-                                                      static_cast<uint32_t>(curr.layer_id),
-                                                      static_cast<uint8_t>(curr.extruder_id),
-                                                      static_cast<uint8_t>(curr.cp_color_id),
-                                                      {0.0f, 0.0f}};
+            const libvgcode::PathVertex vertex = {convert(prev.position),
+                                                  curr.height,
+                                                  curr.width,
+                                                  curr.feedrate,
+                                                  prev.actual_feedrate,
+                                                  curr.mm3_per_mm,
+                                                  curr.fan_speed,
+                                                  curr.temperature,
+                                                  convert(curr.extrusion_role),
+                                                  curr_type,
+                                                  static_cast<uint32_t>(curr.gcode_id),
+                                                  static_cast<uint32_t>(curr.layer_id),
+                                                  static_cast<uint8_t>(curr.extruder_id),
+                                                  static_cast<uint8_t>(curr.cp_color_id),
+                                                  {0.0f, 0.0f}};
 #endif // VGCODE_ENABLE_COG_AND_TOOL_MARKERS
-                ret.vertices.emplace_back(vertex);
-            }
+            ret.vertices.emplace_back(vertex);
         }
 
 #if VGCODE_ENABLE_COG_AND_TOOL_MARKERS
@@ -507,7 +522,7 @@ GCodeInputData convert(const Slic3r::GCodeProcessorResult &result, const std::ve
 #endif // VGCODE_ENABLE_COG_AND_TOOL_MARKERS
         ret.vertices.emplace_back(vertex);
     }
-    ret.vertices.shrink_to_fit();
+    assert(ret.vertices.size() == vertices_count);
 
     ret.spiral_vase_mode = result.spiral_vase_mode;
 